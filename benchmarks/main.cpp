@@ -0,0 +1,141 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Vinzenz Weist
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <sense/dualsense.h>
+#include <sense/backend.h>
+#include <sense/constants.h>
+#include <sense/pathfinder.h>
+
+#include <fcntl.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <new>
+#include <vector>
+
+/**
+ * @brief number of heap allocations, counted by the replaced global operator new.
+ */
+static std::atomic<uint64_t> allocations = {};
+
+void* operator new(const std::size_t size) {
+    allocations.fetch_add(1, std::memory_order::relaxed);
+    if (void* data = std::malloc(size == 0 ? 1 : size)) { return data; } throw std::bad_alloc();
+}
+
+void operator delete(void* data) noexcept { std::free(data); }
+void operator delete(void* data, std::size_t) noexcept { std::free(data); }
+
+/**
+ * @brief measure the cost of a call.
+ *
+ * @param name the name printed in the report.
+ * @param iterations the number of calls.
+ * @param call the call to measure.
+ */
+template <typename F>
+static void get_cost(const char* name, const std::size_t iterations, F&& call) {
+    const auto allocations_before = allocations.load(std::memory_order::relaxed); const auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < iterations; ++i) { call(i); }
+    const auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    const auto allocated = static_cast<double>(allocations.load(std::memory_order::relaxed) - allocations_before);
+    std::printf("%-28s %10.1f ns/call %8.2f allocs/call\n", name, elapsed / static_cast<double>(iterations), allocated / static_cast<double>(iterations));
+}
+
+/**
+ * @brief print percentiles of latency samples.
+ *
+ * @param name the name printed in the report.
+ * @param samples the samples in nanoseconds, gets sorted.
+ */
+static void get_percentiles(const char* name, std::vector<int64_t>& samples) {
+    if (samples.empty()) { return; } std::ranges::sort(samples);
+    const auto at = [&samples](const double ratio) { return samples[std::min(samples.size() - 1, static_cast<std::size_t>(ratio * static_cast<double>(samples.size())))]; };
+    std::printf("%-28s p50 %8ld ns  p99 %8ld ns  p999 %8ld ns  max %8ld ns\n", name, at(0.5), at(0.99), at(0.999), samples.back());
+}
+
+int main() {
+    constexpr std::size_t ITERATIONS = 1000000; constexpr std::size_t EVENTS = 2000000; constexpr std::size_t SAMPLES = 20000;
+    auto backend = std::make_shared<sense::SyntheticBackend>();
+    auto sense = sense::DualSense(std::make_shared<sense::Reactor>(), backend, 0);
+    if (!sense.set_open()) { std::printf("failed to open synthetic device\n"); return 1; }
+
+    // throughput of the event path: socket read, batch apply and seqlock publish.
+    std::array<js_event, 64> events = {};
+    for (std::size_t i = 0; i < events.size(); ++i) { events[i] = { 0, static_cast<int16_t>(i), JS_EVENT_AXIS, static_cast<uint8_t>(i % sense::AXIS_COUNT) }; }
+    const auto before = sense.get_metrics().input; const auto start = std::chrono::steady_clock::now();
+    for (std::size_t sent = 0; sent < EVENTS; sent += events.size()) { while (!backend->set_events(events)) { std::this_thread::yield(); } }
+    // wait on the event counter, an axis value repeats across batches and could match before the last one arrived.
+    while (sense.get_metrics().input.events - before.events < EVENTS) { std::this_thread::yield(); }
+    const auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    const auto stats = sense.get_metrics().input; const auto reads = stats.reads - before.reads;
+    std::printf("%-28s %10.0f events/s %8.1f events/read\n", "event path", static_cast<double>(EVENTS) / seconds, static_cast<double>(stats.events - before.events) / static_cast<double>(std::max<uint64_t>(1, reads)));
+
+    // latency from event arrival to consumer visibility, with a sleeping and a busy polling reactor.
+    std::vector<int64_t> samples; samples.reserve(SAMPLES);
+    for (const auto& [name, busy_poll] : { std::pair{ "event to visibility", 0 }, std::pair{ "event to visibility (busy)", 200 } }) {
+        // busy polling only pays off with a cpu to spare, on a single cpu it starves the producer.
+        if (busy_poll != 0 && std::thread::hardware_concurrency() < 2) { continue; }
+        sense.set_scheduling({ .busy_poll = std::chrono::microseconds(busy_poll) }); samples.clear();
+        for (std::size_t i = 0; i < SAMPLES; ++i) {
+            const auto value = static_cast<int16_t>(i % 2 == 0 ? 1000 + i % 1000 : -1000 - static_cast<int>(i % 1000));
+            const std::array<js_event, 1> event = {{ { 0, value, JS_EVENT_AXIS, sense::AXIS_LEFT_THUMB_X } }};
+            const auto sent = std::chrono::steady_clock::now(); backend->set_events(event);
+            while (sense.snapshot().axis[sense::AXIS_LEFT_THUMB_X] != value) {}
+            samples.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - sent).count());
+        }
+        get_percentiles(name, samples);
+    }
+    sense.set_scheduling({});
+    std::printf("%-28s %10llu\n", "snapshot retries", static_cast<unsigned long long>(sense.get_metrics().snapshot_retries));
+
+    // state getters.
+    auto sequence = uint64_t{}; auto value = int16_t{};
+    get_cost("snapshot", ITERATIONS, [&](std::size_t) { sequence += sense.snapshot().sequence; });
+    get_cost("get_buttons", ITERATIONS / 10, [&](std::size_t) { value += sense.get_buttons()[sense::BUTTON_CROSS]; });
+    get_cost("get_axis", ITERATIONS / 10, [&](std::size_t) { value += sense.get_axis()[sense::AXIS_LEFT_TRIGGER]; });
+    const auto state = sense.snapshot();
+    get_cost("ControllerState::get", ITERATIONS, [&](std::size_t) { value += state.get<sense::BUTTON_CROSS>() + state.get<sense::AXIS_LEFT_TRIGGER>(); });
+    const auto processor = sense::Processor(); auto normalized = std::array<float, sense::AXIS_COUNT>{}; auto raw = std::array<int16_t, sense::AXIS_COUNT>{};
+    get_cost("Processor::get_axis", ITERATIONS, [&](const std::size_t i) { raw[0] = static_cast<int16_t>(i); processor.get_axis(raw, normalized); value += static_cast<int16_t>(normalized[0]); });
+
+    // sysfs access against a tmpfs stand-in.
+    const auto root = std::filesystem::temp_directory_path() / "sense-bench"; std::filesystem::create_directories(root);
+    const auto path = (root / "capacity").string(); std::ofstream(path) << "100\n";
+    auto pathfinder = sense::Pathfinder(); std::array<char, 16> buffer = {};
+    get_cost("Pathfinder::get_value(path)", ITERATIONS / 10, [&](std::size_t) { value += static_cast<int16_t>(pathfinder.get_value(path).size()); });
+    get_cost("Pathfinder::set_value(path)", ITERATIONS / 10, [&](std::size_t) { pathfinder.set_value(path, "100"); });
+    pathfinder.set_open(sense::PATH_BATTERY_CAPACITY, path, O_RDWR);
+    get_cost("Pathfinder::get_value(id)", ITERATIONS, [&](std::size_t) { value += static_cast<int16_t>(pathfinder.get_value(sense::PATH_BATTERY_CAPACITY, buffer).size()); });
+    get_cost("Pathfinder::set_value(id)", ITERATIONS, [&](std::size_t) { pathfinder.set_value(sense::PATH_BATTERY_CAPACITY, "100"); });
+    get_cost("DualSense::set_led", ITERATIONS, [&](const std::size_t i) { sense.set_led(static_cast<uint8_t>(i), 0, 255); });
+    std::filesystem::remove_all(root);
+
+    std::printf("checksum %lu %i\n", sequence, value);
+    return 0;
+}
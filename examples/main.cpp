@@ -39,17 +39,21 @@ int main() {
     sense.set_led(64, 0, 255);
     auto is_running = true;
 
+    // reopen as soon as udev reports the device again, poll if uevents are unavailable.
+    const auto is_hotplug = sense.set_reconnect(true);
+
     // get input while the device is reachable.
     while(is_running) {
         while (!sense.is_active()) {
-            std::printf("wait for connection...\n"); sense.set_open();
-            std::this_thread::sleep_for(std::chrono::milliseconds(1000));
+            std::printf("wait for connection...\n");
+            if (!is_hotplug) { sense.set_open(); }
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
         }
         while (sense.is_active() && is_running) {
-            auto buttons = sense.get_buttons(); auto axis = sense.get_axis();
-            const auto trigger = axis[sense::AXIS_RIGHT_TRIGGER];
-            const auto button = buttons[sense::BUTTON_CROSS];
-            if (buttons[sense::BUTTON_SHARE]) { is_running = false; }
+            const auto state = sense.snapshot();
+            const auto trigger = state.get<sense::AXIS_RIGHT_TRIGGER>();
+            const auto button = state.get<sense::BUTTON_CROSS>();
+            if (state.get<sense::BUTTON_SHARE>()) { is_running = false; }
 
             std::printf("trigger value %i, button value: %i\n", trigger, button);
             std::this_thread::sleep_for(std::chrono::milliseconds(100));
@@ -0,0 +1,267 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Vinzenz Weist
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+#include <array>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <linux/joystick.h>
+
+#include "constants.h"
+#include "device.h"
+#include "topology.h"
+
+namespace sense {
+    /**
+     * @brief Backend provides access to the nodes of one device.
+     */
+    class Backend {
+    protected:
+        /**
+         * @brief the device nodes.
+         */
+        DevicePaths paths_ = {};
+
+    public:
+        /**
+         * @brief create instance of `Backend`.
+         *
+         * @param paths the device nodes.
+         */
+        explicit Backend(DevicePaths paths = {});
+
+        /**
+         * @brief destroy instance of `Backend`.
+         */
+        virtual ~Backend();
+
+        /**
+         * @brief get the device nodes.
+         */
+        [[nodiscard]] const DevicePaths& get_paths() const;
+
+        /**
+         * @brief get the device nodes as connected right now, nodes which are not given are completed where the backend can look them up.
+         *
+         * @return the paths, the `hid` parent is empty if unknown.
+         */
+        [[nodiscard]] virtual DevicePaths get_device() const;
+
+        /**
+         * @brief mark looked up nodes as outdated, called on hot-plug.
+         */
+        virtual void set_invalidate();
+
+        /**
+         * @brief open an event stream, the caller owns the returned file descriptor.
+         *
+         * @param source the stream to open.
+         * @return a non blocking file descriptor or -1 on failure.
+         */
+        virtual int set_open(SenseSourceConstants source) = 0;
+
+        /**
+         * @brief get the rgb led sysfs directory.
+         *
+         * @return the directory or empty if none.
+         */
+        virtual std::string get_led_path() = 0;
+
+        /**
+         * @brief get the battery sysfs directory.
+         *
+         * @return the directory or empty if none.
+         */
+        virtual std::string get_battery_path() = 0;
+    };
+
+    /**
+     * @brief EvdevBackend opens real device nodes, nodes which are not given are taken from the index of connected devices.
+     */
+    class EvdevBackend final : public Backend {
+        /**
+         * @brief the directory containing event nodes.
+         */
+        std::string input_root_ = {};
+
+        /**
+         * @brief the sysfs class directory.
+         */
+        std::string sysfs_root_ = {};
+
+        /**
+         * @brief the index of connected devices, nodes which are not given are looked up here first.
+         */
+        std::shared_ptr<Topology> topology_ = {};
+
+        /**
+         * @brief status if missing nodes may be searched for, only while the index knows no device at all.
+         *
+         * @return bool indicates a search cannot pick up the node of another device.
+         */
+        bool is_search() const;
+
+    public:
+        /**
+         * @brief create instance of `EvdevBackend`.
+         *
+         * @param paths the device nodes, empty nodes are looked up in the shared `Topology`, searched for only without an index.
+         * @param input_root the directory containing event nodes.
+         * @param sysfs_root the sysfs class directory containing "input", "leds" and "power_supply".
+         */
+        explicit EvdevBackend(DevicePaths paths, std::string input_root = "/dev/input/", std::string sysfs_root = "/sys/class/");
+
+        /**
+         * @brief look up this device in the index.
+         *
+         * @return the indexed paths, empty if unknown.
+         */
+        [[nodiscard]] DevicePaths get_device() const override;
+
+        void set_invalidate() override;
+
+        int set_open(SenseSourceConstants source) override;
+
+        std::string get_led_path() override;
+
+        std::string get_battery_path() override;
+    };
+
+    /**
+     * @brief FileBackend opens the given nodes only, e.g. fifos or pipes, and never searches.
+     */
+    class FileBackend final : public Backend {
+    public:
+        /**
+         * @brief create instance of `FileBackend`.
+         *
+         * @param paths the nodes to open, empty nodes are treated as missing.
+         */
+        explicit FileBackend(DevicePaths paths);
+
+        int set_open(SenseSourceConstants source) override;
+
+        std::string get_led_path() override;
+
+        std::string get_battery_path() override;
+    };
+
+    /**
+     * @brief SyntheticBackend is an in-process device fed by the caller, with a temporary sysfs stand-in.
+     */
+    class SyntheticBackend final : public Backend {
+        /**
+         * @brief the write ends of the js, motion sensor and gamepad streams.
+         */
+        std::array<int, 3> write_paths_ = { -1, -1, -1 };
+
+        /**
+         * @brief status if the device can be opened.
+         */
+        bool is_available_ = true;
+
+        /**
+         * @brief status if the gamepad stream is offered instead of the js stream.
+         */
+        bool is_gamepad_ = {};
+
+        /**
+         * @brief the temporary sysfs directory.
+         */
+        std::string root_ = {};
+
+        /**
+         * @brief guards the write ends.
+         */
+        mutable std::mutex lock_ = {};
+
+        /**
+         * @brief write to a stream.
+         *
+         * @param source the stream.
+         * @param data the data.
+         * @param size the size of the data.
+         * @return bool indicates the data was written completely.
+         */
+        bool set_write(SenseSourceConstants source, const void* data, std::size_t size) const;
+
+    public:
+        /**
+         * @brief create instance of `SyntheticBackend`.
+         *
+         * @param is_gamepad offer an evdev gamepad stream instead of the js stream.
+         */
+        explicit SyntheticBackend(bool is_gamepad = false);
+
+        /**
+         * @brief destroy instance of `SyntheticBackend` and remove the sysfs stand-in.
+         */
+        ~SyntheticBackend() override;
+
+        int set_open(SenseSourceConstants source) override;
+
+        std::string get_led_path() override;
+
+        std::string get_battery_path() override;
+
+        /**
+         * @brief feed js events, never blocks.
+         *
+         * @param events the events.
+         * @return false if the stream is closed or full.
+         */
+        bool set_events(std::span<const js_event> events) const;
+
+        /**
+         * @brief feed evdev events, never blocks.
+         *
+         * @param events the events.
+         * @param source the motion sensor or the gamepad stream.
+         * @return false if the stream is closed or full.
+         */
+        bool set_events(std::span<const input_event> events, SenseSourceConstants source = SOURCE_SENSOR) const;
+
+        /**
+         * @brief close all streams, the reader sees a disconnect.
+         */
+        void set_disconnect();
+
+        /**
+         * @brief set if the device can be opened.
+         *
+         * @param enable false lets `set_open` fail.
+         */
+        void set_available(bool enable);
+
+        /**
+         * @brief write the battery stand-in.
+         *
+         * @param capacity the capacity in percent.
+         * @param status the charging status.
+         */
+        void set_battery(uint8_t capacity, const std::string& status = "Discharging") const;
+    };
+} // namespace sense
@@ -0,0 +1,330 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Vinzenz Weist
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <thread>
+#include <linux/joystick.h>
+
+#include "constants.h"
+#include "device.h"
+
+namespace sense {
+    /**
+     * @brief CaptureHeader starts every capture file.
+     */
+    struct CaptureHeader {
+        /**
+         * @brief identifies the file format.
+         */
+        std::array<char, 8> magic = { 'S', 'E', 'N', 'S', 'E', 'C', 'A', 'P' };
+
+        /**
+         * @brief the format version.
+         */
+        uint32_t version = 1;
+
+        /**
+         * @brief the size of one record.
+         */
+        uint32_t record_size = {};
+    };
+
+    /**
+     * @brief CaptureRecord is one raw js or evdev event.
+     */
+    struct CaptureRecord {
+        /**
+         * @brief the time the event was read in nanoseconds, `steady_clock`.
+         */
+        int64_t time = {};
+
+        /**
+         * @brief the kernel event time in nanoseconds, millisecond resolution for js events.
+         */
+        int64_t event_time = {};
+
+        /**
+         * @brief the event type.
+         */
+        uint16_t type = {};
+
+        /**
+         * @brief the event code, the button or axis number for js events.
+         */
+        uint16_t code = {};
+
+        /**
+         * @brief the event value.
+         */
+        int32_t value = {};
+
+        /**
+         * @brief the source, `SenseSourceConstants`.
+         */
+        uint8_t source = {};
+
+        /**
+         * @brief reserved, zero.
+         */
+        std::array<uint8_t, 7> reserved = {};
+    };
+
+    static_assert(sizeof(CaptureRecord) == 32, "CaptureRecord must be 32 bytes");
+
+    /**
+     * @brief CaptureWriter appends raw events to a capture file.
+     */
+    class CaptureWriter {
+        /**
+         * @brief number of records buffered before a write.
+         */
+        static constexpr std::size_t BUFFER_COUNT = 128;
+
+        /**
+         * @brief the capture file.
+         */
+        int path_ = -1;
+
+        /**
+         * @brief buffered records.
+         */
+        std::array<CaptureRecord, BUFFER_COUNT> buffer_ = {};
+
+        /**
+         * @brief number of buffered records.
+         */
+        std::size_t count_ = {};
+
+        /**
+         * @brief append one record.
+         *
+         * @param record the record.
+         */
+        void set_record(const CaptureRecord& record);
+
+    public:
+        /**
+         * @brief create instance of `CaptureWriter`, appends to an existing capture.
+         *
+         * @param path the capture file.
+         */
+        explicit CaptureWriter(const std::string& path);
+
+        /**
+         * @brief flush and destroy instance of `CaptureWriter`.
+         */
+        ~CaptureWriter();
+
+        CaptureWriter(const CaptureWriter&) = delete;
+        CaptureWriter& operator=(const CaptureWriter&) = delete;
+
+        /**
+         * @brief status if the capture file is open.
+         */
+        [[nodiscard]] bool is_open() const;
+
+        /**
+         * @brief append js events.
+         *
+         * @param events the events.
+         * @param time the time the events were read in nanoseconds.
+         */
+        void set_record(std::span<const js_event> events, int64_t time);
+
+        /**
+         * @brief append evdev events.
+         *
+         * @param events the events.
+         * @param time the time the events were read in nanoseconds.
+         * @param source the motion sensor or the gamepad node.
+         */
+        void set_record(std::span<const input_event> events, int64_t time, SenseSourceConstants source = SOURCE_SENSOR);
+
+        /**
+         * @brief write all buffered records.
+         */
+        void set_flush();
+    };
+
+    /**
+     * @brief CaptureReader maps a capture file read only.
+     */
+    class CaptureReader {
+        /**
+         * @brief the mapping.
+         */
+        void* data_ = nullptr;
+
+        /**
+         * @brief the size of the mapping.
+         */
+        std::size_t size_ = {};
+
+        /**
+         * @brief the records inside the mapping.
+         */
+        std::span<const CaptureRecord> records_ = {};
+
+    public:
+        /**
+         * @brief create instance of `CaptureReader`.
+         *
+         * @param path the capture file.
+         */
+        explicit CaptureReader(const std::string& path);
+
+        /**
+         * @brief unmap and destroy instance of `CaptureReader`.
+         */
+        ~CaptureReader();
+
+        CaptureReader(const CaptureReader&) = delete;
+        CaptureReader& operator=(const CaptureReader&) = delete;
+
+        /**
+         * @brief status if the capture file is mapped and valid.
+         */
+        [[nodiscard]] bool is_open() const;
+
+        /**
+         * @brief get all complete records.
+         */
+        [[nodiscard]] std::span<const CaptureRecord> get_records() const;
+    };
+
+    /**
+     * @brief Replay feeds a capture into pipes which a `DualSense` reads like device nodes.
+     */
+    class Replay {
+        /**
+         * @brief the records to replay.
+         */
+        std::span<const CaptureRecord> records_ = {};
+
+        /**
+         * @brief replay with the original timing or as fast as possible.
+         */
+        bool is_realtime_ = {};
+
+        /**
+         * @brief the read ends of the js, motion sensor and gamepad pipes.
+         */
+        std::array<int, 3> read_paths_ = { -1, -1, -1 };
+
+        /**
+         * @brief the write ends of the js, motion sensor and gamepad pipes.
+         */
+        std::array<int, 3> write_paths_ = { -1, -1, -1 };
+
+        /**
+         * @brief eventfd which interrupts every wait of the replay thread on stop.
+         */
+        int wake_path_ = -1;
+
+        /**
+         * @brief status if the capture contains gamepad events.
+         */
+        bool is_gamepad_ = {};
+
+        /**
+         * @brief check if terminated.
+         */
+        std::atomic<bool> is_terminated_ = {};
+
+        /**
+         * @brief status if all records were written.
+         */
+        std::atomic<bool> is_finished_ = {};
+
+        /**
+         * @brief the replay thread.
+         */
+        std::thread thread_ = {};
+
+        /**
+         * @brief write a complete buffer, waits while the pipe is full.
+         *
+         * @param path the write end.
+         * @param data the buffer.
+         * @param size the size of the buffer.
+         * @return bool indicates success.
+         */
+        bool set_write(int path, const void* data, std::size_t size) const;
+
+        /**
+         * @brief sleep until a deadline, returns early on stop.
+         *
+         * @param deadline the time to wake up.
+         * @return false if stopped.
+         */
+        bool set_wait(std::chrono::steady_clock::time_point deadline) const;
+
+    public:
+        /**
+         * @brief create instance of `Replay`.
+         *
+         * @param reader the capture, must outlive the `Replay`.
+         * @param is_realtime replay with the original timing, otherwise as fast as possible.
+         */
+        explicit Replay(const CaptureReader& reader, bool is_realtime = true);
+
+        /**
+         * @brief stop and destroy instance of `Replay`.
+         */
+        ~Replay();
+
+        Replay(const Replay&) = delete;
+        Replay& operator=(const Replay&) = delete;
+
+        /**
+         * @brief get the paths to open the replay like a device, through a `FileBackend` to stay free of side effects.
+         *
+         * @return paths of the js and motion sensor pipes, and of the gamepad pipe if the capture contains gamepad events.
+         */
+        [[nodiscard]] DevicePaths get_paths() const;
+
+        /**
+         * @brief start writing the records, the pipes get closed at the end.
+         *
+         * @return bool indicates success.
+         */
+        bool set_start();
+
+        /**
+         * @brief stop writing the records.
+         */
+        void set_stop();
+
+        /**
+         * @brief status if all records were written.
+         */
+        [[nodiscard]] bool is_finished() const;
+    };
+} // namespace sense
@@ -56,4 +56,33 @@ namespace sense {
         STATUS = 0x00,
         CAPACITY = 0x01,
     };
+
+    enum SensePathConstants: uint8_t {
+        PATH_LED_RGB = 0x00,
+        PATH_LED_BRIGHTNESS = 0x01,
+        PATH_BATTERY_STATUS = 0x02,
+        PATH_BATTERY_CAPACITY = 0x03
+    };
+
+    enum SenseSourceConstants: uint8_t {
+        SOURCE_INPUT = 0x00,
+        SOURCE_SENSOR = 0x01,
+        SOURCE_GAMEPAD = 0x02
+    };
+
+    enum SenseEventConstants: uint8_t {
+        EVENT_BUTTON_PRESS = 0x01,
+        EVENT_BUTTON_RELEASE = 0x02,
+        EVENT_AXIS = 0x04,
+        EVENT_CONNECT = 0x08,
+        EVENT_DISCONNECT = 0x10,
+        EVENT_TIMEOUT = 0x20,
+        EVENT_ALL = 0x3f
+    };
+
+    enum SenseHotplugConstants: uint8_t {
+        HOTPLUG_ADD = 0x01,
+        HOTPLUG_REMOVE = 0x02,
+        HOTPLUG_LOST = 0x04
+    };
 } // namespace sense
\ No newline at end of file
@@ -0,0 +1,74 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Vinzenz Weist
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+#include <array>
+#include <string>
+
+namespace sense {
+    /**
+     * @brief vendor and product ids of supported devices, as found in the hid device name.
+     */
+    inline constexpr std::array HID_IDS = { ":054C:0CE6.", ":054C:0DF2." };
+
+    /**
+     * @brief DevicePaths holds the nodes that belong to one physical device.
+     */
+    struct DevicePaths {
+        /**
+         * @brief the joystick node, e.g. "/dev/input/js0".
+         */
+        std::string input = {};
+
+        /**
+         * @brief the gamepad event node, e.g. "/dev/input/event20", read instead of the joystick node if set.
+         */
+        std::string gamepad = {};
+
+        /**
+         * @brief the motion sensor event node, empty to search for it.
+         */
+        std::string sensor = {};
+
+        /**
+         * @brief the rgb led sysfs directory, empty to search for it.
+         */
+        std::string led = {};
+
+        /**
+         * @brief the battery sysfs directory, empty to search for it.
+         */
+        std::string battery = {};
+
+        /**
+         * @brief the parent hid sysfs directory, identifies the physical device.
+         */
+        std::string hid = {};
+
+        /**
+         * @brief the device address (`uniq`), stays the same across reconnects.
+         */
+        std::string uniq = {};
+    };
+} // namespace sense
@@ -26,11 +26,25 @@
 #include <array>
 #include <string>
 #include <map>
-#include <thread>
+#include <memory>
+#include <mutex>
+#include <span>
 #include <linux/joystick.h>
 
+#include "backend.h"
+#include "capture.h"
 #include "constants.h"
+#include "device.h"
+#include "history.h"
+#include "hotplug.h"
+#include "metrics.h"
+#include "observer.h"
 #include "pathfinder.h"
+#include "processor.h"
+#include "reactor.h"
+#include "ring.h"
+#include "shared.h"
+#include "state.h"
 
 namespace sense {
     /**
@@ -38,9 +52,14 @@ namespace sense {
      */
     class DualSense {
         /**
-         * @brief stores the devices path.
+         * @brief provides access to the device nodes.
          */
-        const char* device_path_ = {};
+        std::shared_ptr<Backend> backend_ = {};
+
+        /**
+         * @brief guards `backend_` against a swap while another thread copies it, never held across a lookup or a write.
+         */
+        mutable std::mutex backend_lock_ = {};
 
         /**
          * @brief time before timout appears.
@@ -53,19 +72,79 @@ namespace sense {
         bool is_log_ = {};
 
         /**
-         * @brief pathfinder to get and set path values.
+         * @brief pathfinder to set the led values.
          */
         Pathfinder pathfinder_ = Pathfinder();
 
         /**
-         * @brief stores the active js event path.
+         * @brief serializes access to the led pathfinder, held across led writes which may block.
+         */
+        std::mutex sysfs_lock_ = {};
+
+        /**
+         * @brief incremented on close, the led writer closes its stale paths once it sees a new value.
+         */
+        std::atomic<uint32_t> led_generation_ = {};
+
+        /**
+         * @brief the generation the led paths were opened in, `sysfs_lock_` must be held.
+         */
+        uint32_t led_opened_ = {};
+
+        /**
+         * @brief pathfinder to get the battery values.
+         */
+        Pathfinder battery_ = Pathfinder();
+
+        /**
+         * @brief serializes access to the battery pathfinder, never held across led writes.
+         */
+        std::mutex battery_lock_ = {};
+
+        /**
+         * @brief the last written red, green, blue and brightness values, -1 if unknown.
+         */
+        std::array<int, 4> led_values_ = { -1, -1, -1, -1 };
+
+        /**
+         * @brief the event loop servicing this device.
+         */
+        std::shared_ptr<Reactor> reactor_ = {};
+
+        /**
+         * @brief stores the active js event path, or the gamepad event path if `is_gamepad_` is set.
          */
-        std::atomic<int> js_event_path_ = {};
+        int js_event_path_ = -1;
+
+        /**
+         * @brief status if input is read from the evdev gamepad node instead of joydev.
+         */
+        bool is_gamepad_ = {};
+
+        /**
+         * @brief minimum and maximum of each gamepad axis, scaled onto the joydev range.
+         */
+        std::array<std::array<int32_t, 2>, AXIS_COUNT> ranges_ = {};
+
+        /**
+         * @brief set after `SYN_DROPPED` on the gamepad node until the next `SYN_REPORT`.
+         */
+        bool is_input_dropped_ = {};
 
         /**
          * @brief stores the active io event path.
          */
-        std::atomic<int> io_event_path_ = {};
+        int io_event_path_ = -1;
+
+        /**
+         * @brief timerfd for the timeout watchdog.
+         */
+        int timer_path_ = -1;
+
+        /**
+         * @brief reactor watch ids for the js, io and timer paths.
+         */
+        std::array<int, 3> watches_ = { -1, -1, -1 };
 
         /**
          * @brief status if the device is active.
@@ -73,59 +152,311 @@ namespace sense {
         std::atomic<bool> is_active_ = {};
 
         /**
-         * @brief button values.
+         * @brief working copy of the input values, only touched while serialized with the reactor.
+         */
+        ControllerState state_ = {};
+
+        /**
+         * @brief storage for the published input values if none is provided.
+         */
+        Seqlock<ControllerState> storage_ = {};
+
+        /**
+         * @brief the published input values.
+         */
+        Seqlock<ControllerState>* snapshot_ = &storage_;
+
+        /**
+         * @brief normalizes the axis before every publish if `is_processing_` is set.
          */
-        std::map<SenseButtonConstants, int16_t> buttons_ = {};
+        Processor processor_ = Processor();
 
         /**
-         * @brief axis values.
+         * @brief status if the processing stage is enabled.
          */
-        std::map<SenseAxisConstants, int16_t> axis_ = {};
+        bool is_processing_ = {};
+
+        /**
+         * @brief the number of events read per syscall.
+         */
+        static constexpr std::size_t EVENT_COUNT = 64;
+
+        /**
+         * @brief counters of a batched read path, written by the reactor thread only.
+         */
+        struct PathCounter {
+            /**
+             * @brief number of reads that returned events.
+             */
+            std::atomic<uint64_t> reads = {};
+
+            /**
+             * @brief number of events read.
+             */
+            std::atomic<uint64_t> events = {};
+
+            /**
+             * @brief number of bytes read.
+             */
+            std::atomic<uint64_t> bytes = {};
+
+            /**
+             * @brief number of events coalesced by the last read.
+             */
+            std::atomic<uint64_t> last = {};
+
+            /**
+             * @brief largest number of events coalesced by one read.
+             */
+            std::atomic<uint64_t> max = {};
+        };
 
         /**
          * @brief stores the js event data.
          */
-        js_event js_event_ = {};
+        std::array<js_event, EVENT_COUNT> js_events_ = {};
 
         /**
          * @brief stores the input event data.
          */
-        input_event io_event_ = {};
+        std::array<input_event, EVENT_COUNT> io_events_ = {};
+
+        /**
+         * @brief dispatches input edges to subscribers.
+         */
+        Observer observer_ = {};
+
+        /**
+         * @brief edges of the current batch, dispatched once the batch is published.
+         */
+        std::array<SenseEvent, EVENT_COUNT> pending_ = {};
+
+        /**
+         * @brief number of pending edges.
+         */
+        std::size_t pending_count_ = {};
 
         /**
-         * @brief check if terminated.
+         * @brief records raw events if set.
          */
-        std::atomic<bool> is_terminated_ = {};
+        CaptureWriter* capture_ = nullptr;
 
         /**
-         * @brief thread pool.
+         * @brief publishes into shared memory if set.
          */
-        std::array<std::thread, 3> thread_pool_ = {};
+        SharedWriter* shared_ = nullptr;
 
         /**
-         *@brief mutex lock for thread safety.
+         * @brief records every button and axis change if set.
          */
-        std::mutex mutex_lock_ = {};
+        History* history_ = nullptr;
 
         /**
-         * @brief the current time for measuring possible timeout.
+         * @brief read counters for the js and io paths.
          */
-        std::atomic<std::chrono::high_resolution_clock::time_point> current_time_ = {};
+        std::array<PathCounter, 2> path_counters_ = {};
 
         /**
-         * @brief set the input thread.
+         * @brief snapshot reads which raced a publish.
          */
-        void set_input_thread();
+        mutable std::atomic<uint64_t> snapshot_retries_ = {};
 
         /**
-         * @brief set the timestamp thread.
+         * @brief motion samples dropped because the ring was full.
          */
-        void set_timestamp_thread();
+        std::atomic<uint64_t> motion_dropped_ = {};
 
         /**
-         * @brief set the timeout thread.
+         * @brief successful opens, closes of an active device and watchdog timeouts.
          */
-        void set_timeout_thread();
+        std::array<std::atomic<uint64_t>, 3> lifecycle_counters_ = {};
+
+        /**
+         * @brief kernel timestamp to userspace read latency of the sensor path.
+         */
+        Histogram receive_latency_ = {};
+
+        /**
+         * @brief receive latency split by the reactor wakeup, busy polling first.
+         */
+        std::array<Histogram, 2> wake_latency_ = {};
+
+        /**
+         * @brief difference between device and receive intervals of motion reports.
+         */
+        Histogram device_jitter_ = {};
+
+        /**
+         * @brief duration of led writes.
+         */
+        Histogram led_latency_ = {};
+
+        /**
+         * @brief kernel time of the previous `MSC_TIMESTAMP`, unset until the first one.
+         */
+        std::chrono::steady_clock::time_point device_receipt_ = {};
+
+        /**
+         * @brief kernel time of the latest motion report, the watchdog measures device silence from here.
+         */
+        std::chrono::steady_clock::time_point current_time_ = {};
+
+        /**
+         * @brief the time the current batch was read.
+         */
+        std::chrono::steady_clock::time_point receipt_ = {};
+
+        /**
+         * @brief set per `SenseSourceConstants` if the node stamps events with `CLOCK_MONOTONIC`.
+         */
+        std::array<bool, 3> is_kernel_time_ = {};
+
+        /**
+         * @brief smallest observed offset between js event times and the steady clock, nanoseconds.
+         */
+        int64_t js_offset_ = INT64_MAX;
+
+        /**
+         * @brief the motion sample being assembled until the next `SYN_REPORT`.
+         */
+        MotionSample motion_sample_ = {};
+
+        /**
+         * @brief set after `SYN_DROPPED` until the next `SYN_REPORT`.
+         */
+        bool is_motion_dropped_ = {};
+
+        /**
+         * @brief complete motion samples, produced by the reactor thread.
+         */
+        Ring<MotionSample, 256> motion_ = {};
+
+        /**
+         * @brief reopens the device when its nodes appear, unset unless reconnecting is enabled.
+         */
+        std::unique_ptr<Hotplug> hotplug_ = {};
+
+        /**
+         * @brief handle readable js events.
+         */
+        void set_input_event();
+
+        /**
+         * @brief handle readable motion sensor events.
+         */
+        void set_sensor_event();
+
+        /**
+         * @brief handle readable gamepad events.
+         */
+        void set_gamepad_event();
+
+        /**
+         * @brief apply a js event to the working copy.
+         *
+         * @param event the event to apply.
+         * @return true if the working copy changed.
+         */
+        bool set_input(const js_event& event);
+
+        /**
+         * @brief apply a gamepad event to the working copy.
+         *
+         * @param event the event to apply.
+         * @return true if the working copy changed.
+         */
+        bool set_input(const input_event& event);
+
+        /**
+         * @brief store a button or axis value and queue its edge.
+         *
+         * @param value the stored value.
+         * @param type the kind of edge.
+         * @param number the button or axis number.
+         * @param next the new value.
+         * @param time the kernel time of the change.
+         * @return true if the value changed.
+         */
+        bool set_value(int16_t& value, SenseEventConstants type, uint8_t number, int16_t next, std::chrono::steady_clock::time_point time);
+
+        /**
+         * @brief load ranges, buttons and axis of the gamepad node in bulk.
+         *
+         * @return true if the working copy changed.
+         */
+        bool set_sync();
+
+        /**
+         * @brief apply a motion sensor event.
+         *
+         * @param event the event to apply.
+         */
+        void set_sensor(const input_event& event);
+
+        /**
+         * @brief dispatch a connection event to subscribers.
+         *
+         * @param type the kind of event.
+         */
+        void set_notify(SenseEventConstants type);
+
+        /**
+         * @brief publish the battery and connection status into shared memory.
+         */
+        void set_status();
+
+        /**
+         * @brief count a batched read.
+         *
+         * @param counter the counter of the read path.
+         * @param count the number of events read.
+         * @param bytes the number of bytes read.
+         */
+        static void set_batch(PathCounter& counter, std::size_t count, std::size_t bytes);
+
+        /**
+         * @brief increment a counter written by a single thread.
+         *
+         * @param counter the counter.
+         */
+        static void set_count(std::atomic<uint64_t>& counter);
+
+        /**
+         * @brief handle the expired timeout watchdog.
+         */
+        void set_timeout_event();
+
+        /**
+         * @brief record the receive latency of a batch.
+         *
+         * @param event the latest event of the batch.
+         * @param source the node the batch was read from.
+         */
+        void set_latency(const input_event& event, SenseSourceConstants source);
+
+        /**
+         * @brief arm the timeout watchdog.
+         *
+         * @param deadline the time the watchdog fires.
+         */
+        void set_timeout(std::chrono::steady_clock::time_point deadline) const;
+
+        /**
+         * @brief map the millisecond time of a js event onto the steady clock.
+         *
+         * @param event the event.
+         * @return the estimated kernel time of the event.
+         */
+        std::chrono::steady_clock::time_point get_time(const js_event& event);
+
+        /**
+         * @brief get the kernel time of an evdev event.
+         *
+         * @param event the event.
+         * @param source the node the event was read from.
+         * @return the event time, or the batch receive time if the node does not use the steady clock.
+         */
+        [[nodiscard]] std::chrono::steady_clock::time_point get_time(const input_event& event, SenseSourceConstants source) const;
 
         /**
          * @brief set default input values.
@@ -133,9 +464,34 @@ namespace sense {
         void reset_input();
 
         /**
-         * @brief get the sensor event path.
+         * @brief publish the working copy of the input values.
+         */
+        void set_publish();
+
+        /**
+         * @brief get the current backend from any thread.
+         *
+         * @return the backend.
+         */
+        std::shared_ptr<Backend> get_backend() const;
+
+        /**
+         * @brief close stale and open missing led paths, `sysfs_lock_` must be held.
          */
-        static std::string get_sensor_path();
+        void set_sysfs();
+
+        /**
+         * @brief resolve and open the battery paths which are not open yet, `battery_lock_` must be held.
+         */
+        void set_battery();
+
+        /**
+         * @brief read the battery capacity without searching, `battery_lock_` must be held.
+         *
+         * @return the capacity in percent or -1 if unknown.
+         */
+        int get_battery();
+
 
     public:
         /**
@@ -146,6 +502,26 @@ namespace sense {
          */
         explicit DualSense(const char* path = "/dev/input/js0", uint16_t timeout = 1000);
 
+        /**
+         * @brief create instance of `DualSense` serviced by a shared event loop.
+         *
+         * @param reactor the event loop, may be shared by several devices.
+         * @param paths the device nodes, empty nodes are searched for.
+         * @param timeout the time before connection gets closed because of non responsibility.
+         * @param snapshot external storage for the published input values, nullptr to use internal storage.
+         */
+        DualSense(std::shared_ptr<Reactor> reactor, DevicePaths paths, uint16_t timeout = 1000, Seqlock<ControllerState>* snapshot = nullptr);
+
+        /**
+         * @brief create instance of `DualSense` reading through a backend.
+         *
+         * @param reactor the event loop, may be shared by several devices.
+         * @param backend provides access to the device nodes.
+         * @param timeout the time before connection gets closed because of non responsibility.
+         * @param snapshot external storage for the published input values, nullptr to use internal storage.
+         */
+        DualSense(std::shared_ptr<Reactor> reactor, std::shared_ptr<Backend> backend, uint16_t timeout = 1000, Seqlock<ControllerState>* snapshot = nullptr);
+
         /**
          * @brief destroy instance of `DualSense`.
          */
@@ -156,6 +532,25 @@ namespace sense {
          */
         [[nodiscard]] bool is_active() const;
 
+        /**
+         * @brief get a copy of the device nodes, serialized with `set_backend`.
+         */
+        [[nodiscard]] DevicePaths get_paths() const;
+
+        /**
+         * @brief get the device nodes, nodes which were not given are looked up by the backend, callable from any thread.
+         *
+         * @return the paths, empty nodes are unknown.
+         */
+        [[nodiscard]] DevicePaths get_device_paths() const;
+
+        /**
+         * @brief close the device and read through another backend, hooks, subscriptions and the snapshot storage are kept.
+         *
+         * @param backend provides access to the device nodes.
+         */
+        void set_backend(std::shared_ptr<Backend> backend);
+
         /**
          * @brief set logging.
          *
@@ -164,7 +559,7 @@ namespace sense {
         void set_logging(bool enable);
 
         /**
-         * @brief open the connection to a device's path.
+         * @brief open the connection to a device's path, an active device opens a motion sensor which appeared later.
          *
          * @return bool indicates success.
          */
@@ -178,14 +573,99 @@ namespace sense {
         bool set_close();
 
         /**
-         * @brief get buttons.
+         * @brief get a consistent copy of all input values without locking.
+         *
+         * @return the latest published `ControllerState`.
+         */
+        [[nodiscard]] ControllerState snapshot() const;
+
+        /**
+         * @brief get the runtime metrics, safe from any thread.
+         *
+         * @return a copy of the counters and histograms.
+         */
+        [[nodiscard]] Metrics get_metrics() const;
+
+        /**
+         * @brief remove the oldest motion samples, must only be called from one consumer thread.
+         *
+         * @param samples receives up to `samples.size()` samples, oldest first.
+         * @return the number of samples removed.
+         */
+        std::size_t get_motion(std::span<MotionSample> samples);
+
+        /**
+         * @brief record all raw js and motion sensor events.
+         *
+         * @param writer the capture to append to, nullptr to stop recording, must stay valid while set.
+         */
+        void set_capture(CaptureWriter* writer);
+
+        /**
+         * @brief publish input, motion, battery and connection status into shared memory for other processes.
+         *
+         * @param writer the shared region, nullptr to stop publishing, must stay valid while set.
+         */
+        void set_shared(SharedWriter* writer);
+
+        /**
+         * @brief record every button and axis change, including taps shorter than the polling interval.
+         *
+         * @param history the history to append to, nullptr to stop recording, must stay valid while set.
+         */
+        void set_history(History* history);
+
+        /**
+         * @brief normalize the axis once per publish, the result is in `ControllerState::normalized`.
+         *
+         * @param enable enable or disable the processing stage.
+         * @param profile the calibration, deadzones and curves.
+         */
+        void set_processing(bool enable, const InputProfile& profile = {});
+
+        /**
+         * @brief reopen the device as soon as the kernel reports its nodes, without polling.
+         *
+         * @param enable enable or disable reconnecting.
+         * @return bool indicates the uevent socket is listening.
+         */
+        bool set_reconnect(bool enable);
+
+        /**
+         * @brief configure the input thread, applies to every device sharing the reactor.
+         *
+         * @param options the scheduling policy, affinity, memory locking and busy polling.
+         * @return bool indicates every option was applied.
+         */
+        bool set_scheduling(const SchedulingOptions& options);
+
+        /**
+         * @brief register a callback, dispatched from the input thread without allocation.
+         *
+         * @param callback the callback, must not block.
+         * @param context passed to the callback.
+         * @param events bitmask of `SenseEventConstants`, default is all events.
+         * @param threshold minimum axis change since the last notification.
+         * @return the subscription id or -1 if all slots are taken.
+         */
+        int set_subscribe(SenseCallback callback, void* context = nullptr, uint8_t events = EVENT_ALL, uint16_t threshold = 0);
+
+        /**
+         * @brief remove a callback, once returned it is neither running nor called again.
+         *
+         * @param id the subscription id.
+         */
+        void set_unsubscribe(int id);
+
+        /**
+         * @brief get buttons, allocates, prefer `snapshot().get<BUTTON>()` on hot paths.
          *
          * @return map of buttons and values.
          */
         std::map<SenseButtonConstants, int16_t> get_buttons();
 
         /**
-         * @brief get axis.
+         * @brief get axis, allocates, prefer `snapshot().get<AXIS>()` on hot paths.
          *
          * @return map of axis and values.
          */
@@ -208,5 +688,12 @@ namespace sense {
          * [sense::STATUS] or [sense::CAPACITY].
          */
         std::map<SenseStatusConstants, std::string> get_device_info();
+
+        /**
+         * @brief get the battery capacity without allocation.
+         *
+         * @return the capacity in percent or -1 if unknown.
+         */
+        int get_capacity();
     };
 } // namespace sense
\ No newline at end of file
@@ -0,0 +1,187 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Vinzenz Weist
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+#include "constants.h"
+#include "observer.h"
+#include "state.h"
+
+namespace sense {
+    /**
+     * @brief History keeps the latest changes of every button and axis for time based queries.
+     *
+     * written by the input thread only, queries run on any thread without locking or allocation in O(log n).
+     */
+    class History {
+    public:
+        /**
+         * @brief number of changes kept per button and per axis, must be a power of two.
+         */
+        static constexpr std::size_t CAPACITY = 1024;
+
+    private:
+        static_assert((CAPACITY & (CAPACITY - 1)) == 0, "History capacity must be a power of two");
+
+        /**
+         * @brief one change, guarded by its own sequence.
+         */
+        struct Entry {
+            /**
+             * @brief `2 * index + 2` once the change at `index` is complete, odd while it is written.
+             */
+            std::atomic<uint64_t> sequence = {};
+
+            /**
+             * @brief the kernel time of the change in nanoseconds, `steady_clock`.
+             */
+            std::atomic<int64_t> time = {};
+
+            /**
+             * @brief the value in bits 0-15, the press flag in bit 16 and the number of presses up to here in bits 32-63.
+             */
+            std::atomic<uint64_t> data = {};
+        };
+
+        /**
+         * @brief a decoded change.
+         */
+        struct Sample {
+            /**
+             * @brief the kernel time of the change in nanoseconds.
+             */
+            int64_t time = {};
+
+            /**
+             * @brief the new value.
+             */
+            int16_t value = {};
+
+            /**
+             * @brief status if the change is a button press.
+             */
+            bool is_press = {};
+
+            /**
+             * @brief number of presses up to and including this change.
+             */
+            uint32_t presses = {};
+        };
+
+        /**
+         * @brief the changes of one button or axis.
+         */
+        struct Track {
+            /**
+             * @brief number of changes ever written.
+             */
+            alignas(64) std::atomic<uint64_t> head = {};
+
+            /**
+             * @brief number of presses ever written, only touched by the writer.
+             */
+            uint32_t presses = {};
+
+            /**
+             * @brief the latest changes, indexed by `index % CAPACITY`.
+             */
+            std::array<Entry, CAPACITY> entries = {};
+        };
+
+        /**
+         * @brief one track per button followed by one per axis.
+         */
+        std::array<Track, BUTTON_COUNT + AXIS_COUNT> tracks_ = {};
+
+        /**
+         * @brief read a change.
+         *
+         * @param track the track.
+         * @param index the absolute index of the change.
+         * @param sample receives the change.
+         * @return false if the change was overwritten or is being written.
+         */
+        static bool get_sample(const Track& track, uint64_t index, Sample& sample);
+
+        /**
+         * @brief find the first change after a time.
+         *
+         * @param track the track.
+         * @param head the number of changes to search.
+         * @param time the time in nanoseconds.
+         * @return the index of the first retained change later than `time`, `head` if there is none.
+         */
+        static uint64_t get_upper(const Track& track, uint64_t head, int64_t time);
+
+        /**
+         * @brief number of presses up to a time.
+         *
+         * @param track the track.
+         * @param head the number of changes to search.
+         * @param time the time in nanoseconds.
+         * @return the number of presses, counted from the first retained change.
+         */
+        static uint32_t get_count(const Track& track, uint64_t head, int64_t time);
+
+    public:
+        /**
+         * @brief append a button or axis change, must only be called from one thread, other events are ignored.
+         *
+         * @param event the change.
+         */
+        void set_event(const SenseEvent& event);
+
+        /**
+         * @brief check if a button was pressed at any point since a time, including a button held since before.
+         *
+         * @param button the button.
+         * @param since the time.
+         * @return true if the button was down at some point in `[since, now]`.
+         */
+        [[nodiscard]] bool is_pressed_since(SenseButtonConstants button, std::chrono::steady_clock::time_point since) const;
+
+        /**
+         * @brief count the presses of a button in a window, presses older than the retained changes are not counted.
+         *
+         * @param button the button.
+         * @param begin the start of the window, exclusive.
+         * @param end the end of the window, inclusive.
+         * @return the number of presses.
+         */
+        [[nodiscard]] std::size_t get_presses(SenseButtonConstants button, std::chrono::steady_clock::time_point begin, std::chrono::steady_clock::time_point end) const;
+
+        /**
+         * @brief get the value of an axis at a time, linearly interpolated between the surrounding changes.
+         *
+         * @param axis the axis.
+         * @param time the time.
+         * @return the value, the oldest retained value before the history and the rest value if nothing was recorded.
+         */
+        [[nodiscard]] int16_t get_axis(SenseAxisConstants axis, std::chrono::steady_clock::time_point time) const;
+    };
+} // namespace sense
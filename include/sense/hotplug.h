@@ -0,0 +1,121 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Vinzenz Weist
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+#include <array>
+#include <memory>
+#include <string_view>
+
+#include "constants.h"
+#include "reactor.h"
+
+namespace sense {
+    /**
+     * @brief HotplugEvent describes a device node of a supported device being added or removed.
+     */
+    struct HotplugEvent {
+        /**
+         * @brief the kind of event, `HOTPLUG_LOST` if events were dropped and devices should be searched.
+         */
+        SenseHotplugConstants action = {};
+
+        /**
+         * @brief the node below "/dev/", e.g. "input/js0".
+         */
+        std::string_view name = {};
+
+        /**
+         * @brief the sysfs path of the node below "/sys".
+         */
+        std::string_view path = {};
+    };
+
+    /**
+     * @brief callback invoked on the reactor thread, must not block, must not destroy the dispatching `Hotplug`.
+     */
+    using HotplugCallback = void (*)(const HotplugEvent& event, void* context);
+
+    /**
+     * @brief Hotplug listens for kernel and udev uevents and reports input nodes of supported devices.
+     */
+    class Hotplug {
+        /**
+         * @brief the event loop the socket is watched on.
+         */
+        std::shared_ptr<Reactor> reactor_ = {};
+
+        /**
+         * @brief invoked for every matching event.
+         */
+        HotplugCallback callback_ = nullptr;
+
+        /**
+         * @brief passed to the callback.
+         */
+        void* context_ = nullptr;
+
+        /**
+         * @brief the uevent netlink socket.
+         */
+        int path_ = -1;
+
+        /**
+         * @brief the reactor watch of the socket.
+         */
+        int watch_ = -1;
+
+        /**
+         * @brief receives one uevent.
+         */
+        std::array<char, 8192> buffer_ = {};
+
+        /**
+         * @brief handle readable uevents.
+         */
+        void set_receive();
+
+    public:
+        /**
+         * @brief create instance of `Hotplug` and start listening.
+         *
+         * @param reactor the event loop the callback runs on.
+         * @param callback invoked for every added or removed input node of a supported device.
+         * @param context passed to the callback.
+         */
+        Hotplug(std::shared_ptr<Reactor> reactor, HotplugCallback callback, void* context = nullptr);
+
+        /**
+         * @brief stop listening and destroy instance of `Hotplug`, no callback runs afterwards.
+         */
+        ~Hotplug();
+
+        Hotplug(const Hotplug&) = delete;
+        Hotplug& operator=(const Hotplug&) = delete;
+
+        /**
+         * @brief status if the socket is listening.
+         */
+        [[nodiscard]] bool is_open() const;
+    };
+} // namespace sense
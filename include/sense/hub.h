@@ -0,0 +1,175 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Vinzenz Weist
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+#include <array>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include "device.h"
+#include "dualsense.h"
+#include "hotplug.h"
+#include "reactor.h"
+#include "state.h"
+#include "topology.h"
+
+namespace sense {
+    /**
+     * @brief DualSenseHub is a class to serve all connected Dual Sense Devices from one event loop.
+     */
+    class DualSenseHub {
+    public:
+        /**
+         * @brief maximum number of devices served at once.
+         */
+        static constexpr std::size_t SLOT_COUNT = 16;
+
+    private:
+        /**
+         * @brief time before timout appears.
+         */
+        uint16_t timeout_ = {};
+
+        /**
+         * @brief logging state.
+         */
+        bool is_log_ = {};
+
+        /**
+         * @brief the event loop shared by all devices.
+         */
+        std::shared_ptr<Reactor> reactor_ = std::make_shared<Reactor>();
+
+        /**
+         * @brief the published input values, indexed by slot.
+         */
+        std::array<Seqlock<ControllerState>, SLOT_COUNT> states_ = {};
+
+        /**
+         * @brief the devices, indexed by slot, only touched on the reactor, never destroyed before the hub.
+         */
+        std::array<std::unique_ptr<DualSense>, SLOT_COUNT> devices_ = {};
+
+        /**
+         * @brief the pass of `set_devices` in which each slot was last seen active.
+         */
+        std::array<uint64_t, SLOT_COUNT> seen_ = {};
+
+        /**
+         * @brief the number of `set_devices` passes.
+         */
+        uint64_t passes_ = {};
+
+        /**
+         * @brief opens devices when their nodes appear, unset unless hot-plugging is enabled.
+         */
+        std::unique_ptr<Hotplug> hotplug_ = {};
+
+        /**
+         * @brief the index of connected devices, rebuilt on `set_open` and hot-plug.
+         */
+        std::shared_ptr<Topology> topology_ = Topology::get_shared();
+
+        /**
+         * @brief open all connected devices which are not active yet, must run on the reactor.
+         *
+         * @return the number of active devices.
+         */
+        std::size_t set_devices();
+
+    public:
+        /**
+         * @brief create instance of `DualSenseHub`.
+         *
+         * @param timeout the time before a connection gets closed because of non responsibility.
+         */
+        explicit DualSenseHub(uint16_t timeout = 1000);
+
+        /**
+         * @brief destroy instance of `DualSenseHub`.
+         */
+        ~DualSenseHub();
+
+        /**
+         * @brief set logging for all devices.
+         *
+         * @param enable enable or disable logging.
+         */
+        void set_logging(bool enable);
+
+        /**
+         * @brief search for devices and open all which are not active yet.
+         *
+         * @return the number of active devices.
+         */
+        std::size_t set_open();
+
+        /**
+         * @brief close all devices.
+         */
+        void set_close();
+
+        /**
+         * @brief open devices as soon as the kernel reports their nodes, without polling.
+         *
+         * @param enable enable or disable hot-plugging.
+         * @return bool indicates the uevent socket is listening.
+         */
+        bool set_hotplug(bool enable);
+
+        /**
+         * @brief get the device in a slot.
+         *
+         * @param slot the slot index.
+         * @return the device or nullptr if the slot is empty, once set it stays valid for the lifetime of the hub and serves whichever device reuses the slot.
+         */
+        [[nodiscard]] DualSense* get_device(std::size_t slot) const;
+
+        /**
+         * @brief get a consistent copy of the input values of one slot.
+         *
+         * @param slot the slot index.
+         * @return the latest published `ControllerState`.
+         */
+        [[nodiscard]] ControllerState snapshot(std::size_t slot) const;
+
+        /**
+         * @brief copy the input values of all slots in one linear scan.
+         *
+         * @param states receives up to `SLOT_COUNT` states, indexed by slot.
+         * @return the number of states copied.
+         */
+        std::size_t snapshot(std::span<ControllerState> states) const;
+
+        /**
+         * @brief find all connected devices and pair their nodes by the parent hid device.
+         *
+         * @param sysfs_root the sysfs class directory.
+         * @param input_root the directory containing the device nodes.
+         * @return the paths of each device, ordered by joystick node.
+         */
+        static std::vector<DevicePaths> get_device_paths(const std::string& sysfs_root = "/sys/class/", const std::string& input_root = "/dev/input/");
+    };
+} // namespace sense
@@ -0,0 +1,245 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Vinzenz Weist
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <span>
+#include <thread>
+
+#include "dualsense.h"
+
+namespace sense {
+    /**
+     * @brief Color is a lightbar color.
+     */
+    struct Color {
+        /**
+         * @brief red level 0-255.
+         */
+        uint8_t red = {};
+
+        /**
+         * @brief green level 0-255.
+         */
+        uint8_t green = {};
+
+        /**
+         * @brief blue level 0-255.
+         */
+        uint8_t blue = {};
+
+        /**
+         * @brief brightness level 0-255.
+         */
+        uint8_t brightness = 255;
+
+        bool operator==(const Color&) const = default;
+    };
+
+    /**
+     * @brief Keyframe is a color reached by a linear fade from the previous one.
+     */
+    struct Keyframe {
+        /**
+         * @brief the color to reach.
+         */
+        Color color = {};
+
+        /**
+         * @brief the duration of the fade in milliseconds.
+         */
+        uint16_t duration = {};
+    };
+
+    /**
+     * @brief Level maps a battery capacity to a color.
+     */
+    struct Level {
+        /**
+         * @brief the capacity in percent.
+         */
+        uint8_t capacity = {};
+
+        /**
+         * @brief the color at this capacity.
+         */
+        Color color = {};
+    };
+
+    /**
+     * @brief Lightbar animates the lightbar from its own worker, callers never block on the device.
+     */
+    class Lightbar {
+    public:
+        /**
+         * @brief maximum number of keyframes or levels per animation.
+         */
+        static constexpr std::size_t KEYFRAME_COUNT = 8;
+
+    private:
+        /**
+         * @brief an animation as posted to the worker.
+         */
+        struct Animation {
+            /**
+             * @brief the keyframes, played in order.
+             */
+            std::array<Keyframe, KEYFRAME_COUNT> keyframes = {};
+
+            /**
+             * @brief the battery levels, ordered by capacity, used if `level_count` is non zero.
+             */
+            std::array<Level, KEYFRAME_COUNT> levels = {};
+
+            /**
+             * @brief number of keyframes.
+             */
+            uint8_t keyframe_count = {};
+
+            /**
+             * @brief number of levels.
+             */
+            uint8_t level_count = {};
+
+            /**
+             * @brief restart after the last keyframe.
+             */
+            bool is_repeat = {};
+        };
+
+        /**
+         * @brief the device to animate.
+         */
+        DualSense& device_;
+
+        /**
+         * @brief time between two frames.
+         */
+        std::chrono::milliseconds frame_interval_ = {};
+
+        /**
+         * @brief the latest posted animation, older ones are dropped.
+         */
+        Animation mailbox_ = {};
+
+        /**
+         * @brief incremented with every post.
+         */
+        uint64_t version_ = {};
+
+        /**
+         * @brief guards the mailbox, never held during device writes.
+         */
+        std::mutex mailbox_lock_ = {};
+
+        /**
+         * @brief wakes the worker on a post.
+         */
+        std::condition_variable condition_ = {};
+
+        /**
+         * @brief check if terminated.
+         */
+        bool is_terminated_ = {};
+
+        /**
+         * @brief the worker thread.
+         */
+        std::thread thread_ = {};
+
+        /**
+         * @brief run the worker.
+         */
+        void set_loop();
+
+        /**
+         * @brief post an animation, replacing the pending one.
+         *
+         * @param animation the animation.
+         */
+        void set_post(const Animation& animation);
+
+        /**
+         * @brief interpolate between two colors.
+         *
+         * @param from the start color.
+         * @param to the end color.
+         * @param ratio 0 for `from`, 1 for `to`.
+         * @return the interpolated color.
+         */
+        static Color get_mix(const Color& from, const Color& to, float ratio);
+
+    public:
+        /**
+         * @brief create instance of `Lightbar` and start its worker.
+         *
+         * @param device the device to animate, must outlive the `Lightbar`.
+         * @param frame_rate frames per second while animating.
+         */
+        explicit Lightbar(DualSense& device, uint16_t frame_rate = 60);
+
+        /**
+         * @brief stop the worker and destroy instance of `Lightbar`.
+         */
+        ~Lightbar();
+
+        Lightbar(const Lightbar&) = delete;
+        Lightbar& operator=(const Lightbar&) = delete;
+
+        /**
+         * @brief set a solid color.
+         *
+         * @param color the color.
+         */
+        void set_color(const Color& color);
+
+        /**
+         * @brief fade through keyframes, starting from the current color.
+         *
+         * @param keyframes up to `KEYFRAME_COUNT` keyframes.
+         * @param is_repeat restart after the last keyframe.
+         */
+        void set_fade(std::span<const Keyframe> keyframes, bool is_repeat = false);
+
+        /**
+         * @brief pulse the brightness of a color until another animation is posted.
+         *
+         * @param color the color at full brightness.
+         * @param period the duration of one pulse in milliseconds.
+         */
+        void set_pulse(const Color& color, uint16_t period = 1000);
+
+        /**
+         * @brief follow the battery capacity with colors interpolated between levels.
+         *
+         * @param levels up to `KEYFRAME_COUNT` levels, ordered by capacity, default is red to green.
+         */
+        void set_battery(std::span<const Level> levels = {});
+    };
+} // namespace sense
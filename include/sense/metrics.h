@@ -0,0 +1,193 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Vinzenz Weist
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <string>
+
+namespace sense {
+    /**
+     * @brief HistogramSnapshot is a copy of a `Histogram`.
+     */
+    struct HistogramSnapshot {
+        /**
+         * @brief number of values per power of two, bucket `i` holds values below `2^i`.
+         */
+        std::array<uint64_t, 65> buckets = {};
+
+        /**
+         * @brief number of values.
+         */
+        uint64_t count = {};
+
+        /**
+         * @brief sum of all values.
+         */
+        uint64_t sum = {};
+
+        /**
+         * @brief estimate a percentile.
+         *
+         * @param ratio the percentile, e.g. 0.99.
+         * @return the upper bound of the bucket containing the percentile.
+         */
+        [[nodiscard]] uint64_t get_percentile(double ratio) const;
+    };
+
+    /**
+     * @brief Histogram counts values in power of two buckets with relaxed atomics.
+     */
+    class Histogram {
+        /**
+         * @brief number of values per power of two.
+         */
+        std::array<std::atomic<uint64_t>, 65> buckets_ = {};
+
+        /**
+         * @brief sum of all values.
+         */
+        std::atomic<uint64_t> sum_ = {};
+
+    public:
+        /**
+         * @brief add a value, safe from any thread.
+         *
+         * @param value the value.
+         */
+        void set_value(uint64_t value) {
+            buckets_[std::bit_width(value)].fetch_add(1, std::memory_order::relaxed); sum_.fetch_add(value, std::memory_order::relaxed);
+        }
+
+        /**
+         * @brief copy the histogram.
+         */
+        [[nodiscard]] HistogramSnapshot get_snapshot() const;
+    };
+
+    /**
+     * @brief PathMetrics describes one event stream.
+     */
+    struct PathMetrics {
+        /**
+         * @brief number of read syscalls that returned events.
+         */
+        uint64_t reads = {};
+
+        /**
+         * @brief number of events read.
+         */
+        uint64_t events = {};
+
+        /**
+         * @brief number of bytes read.
+         */
+        uint64_t bytes = {};
+
+        /**
+         * @brief number of events coalesced by the last read.
+         */
+        uint64_t last_batch = {};
+
+        /**
+         * @brief largest number of events coalesced by one read.
+         */
+        uint64_t max_batch = {};
+    };
+
+    /**
+     * @brief Metrics is a snapshot of the runtime metrics of a device.
+     */
+    struct Metrics {
+        /**
+         * @brief the js event stream.
+         */
+        PathMetrics input = {};
+
+        /**
+         * @brief the motion sensor event stream.
+         */
+        PathMetrics sensor = {};
+
+        /**
+         * @brief snapshot reads which had to retry because of a concurrent publish.
+         */
+        uint64_t snapshot_retries = {};
+
+        /**
+         * @brief motion samples dropped because the ring was full.
+         */
+        uint64_t motion_dropped = {};
+
+        /**
+         * @brief successful opens.
+         */
+        uint64_t opens = {};
+
+        /**
+         * @brief closes of an active device.
+         */
+        uint64_t closes = {};
+
+        /**
+         * @brief closes caused by the timeout watchdog.
+         */
+        uint64_t timeouts = {};
+
+        /**
+         * @brief time from the kernel event timestamp to the read in userspace, nanoseconds.
+         */
+        HistogramSnapshot receive_latency = {};
+
+        /**
+         * @brief receive latency of reads the reactor found by busy polling, nanoseconds.
+         */
+        HistogramSnapshot busy_latency = {};
+
+        /**
+         * @brief receive latency of reads the reactor was woken for from a blocking wait, nanoseconds.
+         */
+        HistogramSnapshot sleep_latency = {};
+
+        /**
+         * @brief difference between the `MSC_TIMESTAMP` interval and the receive interval, nanoseconds.
+         */
+        HistogramSnapshot device_jitter = {};
+
+        /**
+         * @brief duration of led writes, nanoseconds.
+         */
+        HistogramSnapshot led_latency = {};
+
+        /**
+         * @brief format the metrics as text, one "name value" pair per line.
+         *
+         * @param prefix prepended to every name.
+         * @return the metrics as text.
+         */
+        [[nodiscard]] std::string get_text(const std::string& prefix = "sense_") const;
+    };
+} // namespace sense
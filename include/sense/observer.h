@@ -0,0 +1,177 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Vinzenz Weist
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+#include "constants.h"
+#include "state.h"
+
+namespace sense {
+    /**
+     * @brief SenseEvent describes one input edge or connection change.
+     */
+    struct SenseEvent {
+        /**
+         * @brief the kind of event.
+         */
+        SenseEventConstants type = {};
+
+        /**
+         * @brief the button or axis number, `SenseButtonConstants` or `SenseAxisConstants`.
+         */
+        uint8_t number = {};
+
+        /**
+         * @brief the new button or axis value.
+         */
+        int16_t value = {};
+
+        /**
+         * @brief the kernel time of the event, or the time a connection change was detected.
+         */
+        std::chrono::steady_clock::time_point timestamp = {};
+    };
+
+    /**
+     * @brief callback invoked on the dispatching thread, must not block, may close but must not destroy the dispatching device.
+     */
+    using SenseCallback = void (*)(const SenseEvent& event, void* context);
+
+    /**
+     * @brief Observer dispatches events to a fixed number of subscriptions without locking or allocation.
+     */
+    class Observer {
+    public:
+        /**
+         * @brief maximum number of subscriptions.
+         */
+        static constexpr std::size_t SUBSCRIPTION_COUNT = 16;
+
+    private:
+        /**
+         * @brief a registered callback.
+         */
+        struct Subscription {
+            /**
+             * @brief the callback.
+             */
+            SenseCallback callback = {};
+
+            /**
+             * @brief passed to the callback.
+             */
+            void* context = {};
+
+            /**
+             * @brief bitmask of `SenseEventConstants`.
+             */
+            uint8_t events = {};
+
+            /**
+             * @brief minimum axis change since the last notification.
+             */
+            uint16_t threshold = {};
+
+            /**
+             * @brief unique per registration, resets the axis reference values.
+             */
+            uint64_t generation = {};
+        };
+
+        /**
+         * @brief bitmask of claimed slots.
+         */
+        std::atomic<uint32_t> claimed_ = {};
+
+        /**
+         * @brief bitmask of slots ready for dispatch.
+         */
+        std::atomic<uint32_t> active_ = {};
+
+        /**
+         * @brief number of dispatches in flight, nested dispatches from within a callback included.
+         */
+        std::atomic<uint32_t> dispatches_ = {};
+
+        /**
+         * @brief incremented whenever the outermost dispatch returns.
+         */
+        std::atomic<uint64_t> epoch_ = {};
+
+        /**
+         * @brief source of subscription generations.
+         */
+        std::atomic<uint64_t> generation_ = {};
+
+        /**
+         * @brief the subscriptions, indexed by slot.
+         */
+        std::array<Seqlock<Subscription>, SUBSCRIPTION_COUNT> subscriptions_ = {};
+
+        /**
+         * @brief axis values at the last notification, `INT32_MIN` until the first one, only touched by the dispatcher.
+         */
+        std::array<std::array<int32_t, AXIS_COUNT>, SUBSCRIPTION_COUNT> axis_ = {};
+
+        /**
+         * @brief generation the axis reference values belong to, only touched by the dispatcher.
+         */
+        std::array<uint64_t, SUBSCRIPTION_COUNT> axis_generation_ = {};
+
+    public:
+        /**
+         * @brief register a callback, lock free.
+         *
+         * @param callback the callback.
+         * @param context passed to the callback.
+         * @param events bitmask of `SenseEventConstants`.
+         * @param threshold minimum axis change since the last notification.
+         * @return the subscription id or -1 if all slots are taken.
+         */
+        int set_subscribe(SenseCallback callback, void* context, uint8_t events, uint16_t threshold = 0);
+
+        /**
+         * @brief remove a callback, once returned it is neither running nor called again.
+         *
+         * @param id the subscription id, negative ids are ignored.
+         */
+        void set_unsubscribe(int id);
+
+        /**
+         * @brief check if any subscription is registered.
+         */
+        [[nodiscard]] bool is_active() const;
+
+        /**
+         * @brief dispatch an event, must only be called from one thread at a time.
+         *
+         * @param event the event.
+         */
+        void set_dispatch(const SenseEvent& event);
+    };
+} // namespace sense
@@ -23,12 +23,17 @@
  */
 
 #pragma once
+#include <array>
+#include <span>
 #include <string>
+#include <string_view>
 #include <fstream>
 
+#include "constants.h"
+
 namespace sense {
     /**
-     * @brief Pathfinder is a class to handle to read and write to a fstream.
+     * @brief Pathfinder is a class to handle to read and write to a fstream or to cached file descriptors.
      */
     class Pathfinder {
         /**
@@ -36,6 +41,11 @@ namespace sense {
          */
         std::fstream stream_;
 
+        /**
+         * @brief cached file descriptors, indexed by `SensePathConstants`.
+         */
+        std::array<int, 4> paths_ = { -1, -1, -1, -1 };
+
     public:
         /**
          * @brief create instance of Pathfinder.
@@ -62,5 +72,45 @@ namespace sense {
          * @param value the value to write.
          */
         void set_value(const std::string& path, const std::string& value);
+
+        /**
+         * @brief open and cache a file descriptor, replaces an already cached one.
+         *
+         * @param id the slot to cache the file descriptor in.
+         * @param path the path to open.
+         * @param flags the flags passed to `open`.
+         * @return bool indicates success.
+         */
+        bool set_open(SensePathConstants id, const std::string& path, int flags);
+
+        /**
+         * @brief close all cached file descriptors.
+         */
+        void set_close();
+
+        /**
+         * @brief check if a file descriptor is cached.
+         *
+         * @param id the slot to check.
+         */
+        [[nodiscard]] bool is_open(SensePathConstants id) const;
+
+        /**
+         * @brief read the first token from a cached file descriptor.
+         *
+         * @param id the slot to read from.
+         * @param buffer receives the value, not null terminated.
+         * @return the value inside `buffer`, empty on failure.
+         */
+        std::string_view get_value(SensePathConstants id, std::span<char> buffer) const;
+
+        /**
+         * @brief write to a cached file descriptor.
+         *
+         * @param id the slot to write to.
+         * @param value the value to write.
+         * @return bool indicates success.
+         */
+        bool set_value(SensePathConstants id, std::string_view value) const;
     };
-} // namespace sense
\ No newline at end of file
+} // namespace sense
@@ -0,0 +1,138 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Vinzenz Weist
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+#include <array>
+#include <cstdint>
+
+#include "constants.h"
+#include "state.h"
+
+namespace sense {
+    /**
+     * @brief AxisProfile describes the calibration, deadzone and curve of one axis.
+     */
+    struct AxisProfile {
+        /**
+         * @brief the raw value mapped to -1.
+         */
+        int16_t minimum = -32767;
+
+        /**
+         * @brief the raw value mapped to 0, equal to `minimum` for triggers.
+         */
+        int16_t center = 0;
+
+        /**
+         * @brief the raw value mapped to 1.
+         */
+        int16_t maximum = 32767;
+
+        /**
+         * @brief the axial deadzone 0-1, values below are 0 and the rest is rescaled.
+         */
+        float deadzone = {};
+
+        /**
+         * @brief the response curve 0-1, blends linear into cubic.
+         */
+        float curve = {};
+    };
+
+    /**
+     * @brief InputProfile configures the processing of all axis.
+     */
+    struct InputProfile {
+        /**
+         * @brief the profiles, indexed by `SenseAxisConstants`, triggers rest at their minimum.
+         */
+        std::array<AxisProfile, AXIS_COUNT> axis = {{ {}, {}, { -32767, -32767 }, {}, {}, { -32767, -32767 }, {}, {} }};
+
+        /**
+         * @brief the radial deadzone 0-1 of both thumb sticks, applied to the stick magnitude.
+         */
+        float radial_deadzone = {};
+    };
+
+    /**
+     * @brief Processor normalizes all axis at once with a vectorized kernel.
+     */
+    class Processor {
+        /**
+         * @brief one value per axis.
+         */
+        using Vector = float __attribute__((vector_size(AXIS_COUNT * sizeof(float))));
+
+        /**
+         * @brief the raw value mapped to 0.
+         */
+        Vector center_ = {};
+
+        /**
+         * @brief the scale above the center.
+         */
+        Vector positive_ = {};
+
+        /**
+         * @brief the scale below the center.
+         */
+        Vector negative_ = {};
+
+        /**
+         * @brief the axial deadzone.
+         */
+        Vector deadzone_ = {};
+
+        /**
+         * @brief the scale of the range outside the deadzone.
+         */
+        Vector range_ = {};
+
+        /**
+         * @brief the response curve.
+         */
+        Vector curve_ = {};
+
+        /**
+         * @brief the radial deadzone of the thumb sticks.
+         */
+        float radial_deadzone_ = {};
+
+    public:
+        /**
+         * @brief create instance of `Processor`.
+         *
+         * @param profile the processing configuration.
+         */
+        explicit Processor(const InputProfile& profile = {});
+
+        /**
+         * @brief normalize all axis, sticks to -1 to 1 and triggers to 0 to 1.
+         *
+         * @param raw the raw axis values.
+         * @param axis receives the processed values.
+         */
+        void get_axis(const std::array<int16_t, AXIS_COUNT>& raw, std::array<float, AXIS_COUNT>& axis) const;
+    };
+} // namespace sense
@@ -0,0 +1,222 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Vinzenz Weist
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <sched.h>
+
+namespace sense {
+    /**
+     * @brief SchedulingOptions configure the reactor thread for low wakeup latency.
+     */
+    struct SchedulingOptions {
+        /**
+         * @brief the scheduling policy, `SCHED_OTHER`, `SCHED_FIFO` or `SCHED_RR`.
+         */
+        int policy = SCHED_OTHER;
+
+        /**
+         * @brief the static priority 1-99 for `SCHED_FIFO` and `SCHED_RR`, ignored otherwise.
+         */
+        int priority = {};
+
+        /**
+         * @brief bitmask of the cpus the thread may run on, 0 keeps the current affinity.
+         */
+        uint64_t cpus = {};
+
+        /**
+         * @brief lock all current and future pages with `mlockall`, never undone, the input path allocates nothing after open.
+         */
+        bool is_locked = {};
+
+        /**
+         * @brief poll without sleeping for this long after every wakeup before blocking, 0 to always block.
+         */
+        std::chrono::microseconds busy_poll = {};
+    };
+
+    /**
+     * @brief Reactor is a single threaded event loop built on `epoll`.
+     */
+    class Reactor : public std::enable_shared_from_this<Reactor> {
+        /**
+         * @brief maximum number of watched file descriptors.
+         */
+        static constexpr std::size_t WATCH_COUNT = 128;
+
+        /**
+         * @brief maximum number of events handled per wakeup.
+         */
+        static constexpr int EVENT_COUNT = 64;
+
+        /**
+         * @brief the state of a watch slot.
+         */
+        enum class WatchState: uint8_t { FREE, ACTIVE, RETIRED };
+
+        /**
+         * @brief a watched file descriptor and its handler.
+         */
+        struct Watch {
+            /**
+             * @brief called on the reactor thread when the file descriptor is readable.
+             */
+            std::function<void()> handler = {};
+
+            /**
+             * @brief the watched file descriptor.
+             */
+            int fd = -1;
+
+            /**
+             * @brief incremented whenever the slot gets reused.
+             */
+            uint32_t generation = {};
+
+            /**
+             * @brief the state of the slot.
+             */
+            WatchState state = WatchState::FREE;
+        };
+
+        /**
+         * @brief the epoll file descriptor.
+         */
+        int epoll_fd_ = -1;
+
+        /**
+         * @brief eventfd used to wake the loop for shutdown.
+         */
+        int wake_fd_ = -1;
+
+        /**
+         * @brief check if terminated.
+         */
+        std::atomic<bool> is_terminated_ = {};
+
+        /**
+         * @brief held while handlers are dispatched.
+         */
+        std::recursive_mutex dispatch_lock_ = {};
+
+        /**
+         * @brief the watch slots.
+         */
+        std::array<Watch, WATCH_COUNT> watches_ = {};
+
+        /**
+         * @brief the reactor thread.
+         */
+        std::thread thread_ = {};
+
+        /**
+         * @brief flag on the stack of the running loop, set by a destructor running on the reactor thread.
+         */
+        bool* is_destroyed_ = nullptr;
+
+        /**
+         * @brief the busy poll window in nanoseconds.
+         */
+        std::atomic<int64_t> busy_poll_ = {};
+
+        /**
+         * @brief status if the current round was found by busy polling, only touched by the reactor thread.
+         */
+        bool is_busy_wake_ = {};
+
+        /**
+         * @brief run the event loop.
+         */
+        void set_loop();
+
+    public:
+        /**
+         * @brief create instance of `Reactor` and start the event loop.
+         */
+        Reactor();
+
+        /**
+         * @brief stop the event loop and destroy instance of `Reactor`.
+         *
+         * a handler may release the last `shared_ptr`, the reactor is then destroyed once the current round of handlers returned.
+         */
+        ~Reactor();
+
+        Reactor(const Reactor&) = delete;
+        Reactor& operator=(const Reactor&) = delete;
+
+        /**
+         * @brief watch a file descriptor for readability.
+         *
+         * @param fd the file descriptor to watch.
+         * @param handler called on the reactor thread when `fd` is readable.
+         * @return the watch id or -1 on failure.
+         */
+        int set_watch(int fd, std::function<void()> handler);
+
+        /**
+         * @brief stop watching, once returned the handler is neither running nor called again.
+         *
+         * @param id the watch id returned by `set_watch`, negative ids are ignored.
+         */
+        void set_unwatch(int id);
+
+        /**
+         * @brief check if the caller runs on the reactor thread.
+         */
+        [[nodiscard]] bool is_reactor_thread() const;
+
+        /**
+         * @brief check if the running handler was woken by busy polling, must be called from a handler.
+         */
+        [[nodiscard]] bool is_busy_wake() const;
+
+        /**
+         * @brief apply scheduling policy, affinity, memory locking and busy polling to the reactor thread.
+         *
+         * @param options the options.
+         * @return bool indicates every option was applied, real time policies and locking may need privileges.
+         */
+        bool set_scheduling(const SchedulingOptions& options);
+
+        /**
+         * @brief run a task serialized with all handlers of this reactor.
+         *
+         * @param task the task to run on the calling thread.
+         * @return the result of the task.
+         */
+        template <typename F>
+        auto set_invoke(F&& task) {
+            std::lock_guard lock(dispatch_lock_); return std::forward<F>(task)();
+        }
+    };
+} // namespace sense
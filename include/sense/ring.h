@@ -0,0 +1,91 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Vinzenz Weist
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <span>
+
+namespace sense {
+    /**
+     * @brief Ring is a fixed capacity queue for one producer and one consumer thread.
+     *
+     * @tparam T the item type.
+     * @tparam N the capacity, must be a power of two.
+     */
+    template <typename T, std::size_t N>
+    class Ring {
+        static_assert(N != 0 && (N & (N - 1)) == 0, "Ring capacity must be a power of two");
+
+        /**
+         * @brief write position, only written by the producer.
+         */
+        alignas(64) std::atomic<std::size_t> head_ = {};
+
+        /**
+         * @brief read position, only written by the consumer.
+         */
+        alignas(64) std::atomic<std::size_t> tail_ = {};
+
+        /**
+         * @brief the items.
+         */
+        alignas(64) std::array<T, N> items_ = {};
+
+    public:
+        /**
+         * @brief append an item, must only be called by the producer.
+         *
+         * @param item the item to append.
+         * @return false if the ring is full and the item was dropped.
+         */
+        bool push(const T& item) {
+            const auto head = head_.load(std::memory_order::relaxed);
+            if (head - tail_.load(std::memory_order::acquire) == N) { return false; }
+            items_[head & (N - 1)] = item; head_.store(head + 1, std::memory_order::release); return true;
+        }
+
+        /**
+         * @brief remove the oldest items, must only be called by the consumer.
+         *
+         * @param items receives up to `items.size()` items, oldest first.
+         * @return the number of items removed.
+         */
+        std::size_t pop(std::span<T> items) {
+            const auto tail = tail_.load(std::memory_order::relaxed);
+            const auto count = std::min(items.size(), head_.load(std::memory_order::acquire) - tail);
+            for (std::size_t i = 0; i < count; ++i) { items[i] = items_[(tail + i) & (N - 1)]; }
+            tail_.store(tail + count, std::memory_order::release); return count;
+        }
+
+        /**
+         * @brief the number of items ready to be removed.
+         */
+        [[nodiscard]] std::size_t size() const {
+            return head_.load(std::memory_order::acquire) - tail_.load(std::memory_order::acquire);
+        }
+    };
+} // namespace sense
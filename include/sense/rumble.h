@@ -0,0 +1,198 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Vinzenz Weist
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+#include <array>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+#include "dualsense.h"
+
+namespace sense {
+    /**
+     * @brief Vibration describes the strength of both rumble motors.
+     */
+    struct Vibration {
+        /**
+         * @brief the strong (left) motor 0-65535.
+         */
+        uint16_t strong = {};
+
+        /**
+         * @brief the weak (right) motor 0-65535.
+         */
+        uint16_t weak = {};
+
+        /**
+         * @brief the duration in milliseconds, 0 to play until replaced.
+         */
+        uint16_t duration = {};
+
+        bool operator==(const Vibration&) const = default;
+    };
+
+    /**
+     * @brief Rumble drives the force feedback motors from its own worker, callers never block on the device.
+     */
+    class Rumble {
+    public:
+        /**
+         * @brief number of uploaded effects kept on the device for reuse.
+         */
+        static constexpr std::size_t EFFECT_COUNT = 4;
+
+    private:
+        /**
+         * @brief an effect uploaded to the device.
+         */
+        struct Effect {
+            /**
+             * @brief the uploaded vibration.
+             */
+            Vibration vibration = {};
+
+            /**
+             * @brief the id assigned by the device, -1 if unused.
+             */
+            int16_t id = -1;
+
+            /**
+             * @brief the play count when the effect was last played, the oldest gets replaced.
+             */
+            uint64_t used = {};
+        };
+
+        /**
+         * @brief the device to drive, must outlive the `Rumble`.
+         */
+        DualSense& device_;
+
+        /**
+         * @brief the latest posted vibration, older ones are dropped.
+         */
+        Vibration mailbox_ = {};
+
+        /**
+         * @brief incremented with every post.
+         */
+        uint64_t version_ = {};
+
+        /**
+         * @brief guards the mailbox, never held during device writes.
+         */
+        std::mutex mailbox_lock_ = {};
+
+        /**
+         * @brief wakes the worker on a post.
+         */
+        std::condition_variable condition_ = {};
+
+        /**
+         * @brief check if terminated.
+         */
+        bool is_terminated_ = {};
+
+        /**
+         * @brief the gamepad event node, owned by the worker.
+         */
+        int path_ = -1;
+
+        /**
+         * @brief the uploaded effects, owned by the worker.
+         */
+        std::array<Effect, EFFECT_COUNT> effects_ = {};
+
+        /**
+         * @brief the id of the playing effect, -1 if none.
+         */
+        int16_t playing_ = -1;
+
+        /**
+         * @brief number of played effects.
+         */
+        uint64_t plays_ = {};
+
+        /**
+         * @brief the worker thread.
+         */
+        std::thread thread_ = {};
+
+        /**
+         * @brief run the worker.
+         */
+        void set_loop();
+
+        /**
+         * @brief upload if needed and play a vibration, stops if both motors are off.
+         *
+         * @param vibration the vibration.
+         * @return false if the node failed.
+         */
+        bool set_apply(const Vibration& vibration);
+
+        /**
+         * @brief start or stop an uploaded effect.
+         *
+         * @param id the effect id.
+         * @param is_playing start or stop.
+         * @return bool indicates success.
+         */
+        bool set_play(int16_t id, bool is_playing) const;
+
+        /**
+         * @brief close the node and forget the uploaded effects.
+         */
+        void set_close();
+
+    public:
+        /**
+         * @brief create instance of `Rumble` and start its worker.
+         *
+         * @param device the device to drive, must outlive the `Rumble`.
+         */
+        explicit Rumble(DualSense& device);
+
+        /**
+         * @brief stop the motors and the worker and destroy instance of `Rumble`.
+         */
+        ~Rumble();
+
+        Rumble(const Rumble&) = delete;
+        Rumble& operator=(const Rumble&) = delete;
+
+        /**
+         * @brief play a vibration, replacing the pending and the playing one.
+         *
+         * @param vibration the vibration, both motors off stops.
+         */
+        void set_vibration(const Vibration& vibration);
+
+        /**
+         * @brief stop both motors.
+         */
+        void set_stop();
+    };
+} // namespace sense
@@ -0,0 +1,223 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Vinzenz Weist
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+#include "state.h"
+
+namespace sense {
+    /**
+     * @brief SharedStatus holds the slowly changing device values.
+     */
+    struct SharedStatus {
+        /**
+         * @brief the battery capacity in percent or -1 if unknown.
+         */
+        int32_t capacity = -1;
+
+        /**
+         * @brief status if the device is active.
+         */
+        bool is_active = {};
+    };
+
+    /**
+     * @brief SharedRegion is the layout of the shared memory, every value is published through its own seqlock.
+     */
+    struct SharedRegion {
+        /**
+         * @brief identifies the layout.
+         */
+        std::array<char, 8> magic = { 'S', 'E', 'N', 'S', 'E', 'S', 'H', 'M' };
+
+        /**
+         * @brief the layout version, stored last by the writer, readers reject the region until it matches.
+         */
+        std::atomic<uint32_t> version = {};
+
+        /**
+         * @brief the size of the region.
+         */
+        uint32_t size = sizeof(SharedRegion);
+
+        /**
+         * @brief the published input values.
+         */
+        Seqlock<ControllerState> state = {};
+
+        /**
+         * @brief the latest complete motion sample.
+         */
+        Seqlock<MotionSample> motion = {};
+
+        /**
+         * @brief the battery and connection status.
+         */
+        Seqlock<SharedStatus> status = {};
+    };
+
+    static_assert(std::atomic<uint64_t>::is_always_lock_free && std::atomic<uint32_t>::is_always_lock_free, "SharedRegion requires lock free atomics");
+
+    /**
+     * @brief the current `SharedRegion` layout version.
+     */
+    inline constexpr uint32_t SHARED_VERSION = 1;
+
+    /**
+     * @brief SharedWriter publishes the values of one device into shared memory, written by the input thread only.
+     */
+    class SharedWriter {
+        /**
+         * @brief the shared memory object.
+         */
+        int path_ = -1;
+
+        /**
+         * @brief the name passed to `shm_open`, empty for an anonymous `memfd`.
+         */
+        std::string name_ = {};
+
+        /**
+         * @brief the mapping.
+         */
+        SharedRegion* region_ = nullptr;
+
+    public:
+        /**
+         * @brief create instance of `SharedWriter`.
+         *
+         * @param name the shared memory name, e.g. "/sense-0", empty to create an anonymous `memfd` which is passed to readers by descriptor.
+         */
+        explicit SharedWriter(const std::string& name = {});
+
+        /**
+         * @brief unmap, unlink and destroy instance of `SharedWriter`.
+         */
+        ~SharedWriter();
+
+        SharedWriter(const SharedWriter&) = delete;
+        SharedWriter& operator=(const SharedWriter&) = delete;
+
+        /**
+         * @brief status if the region is mapped.
+         */
+        [[nodiscard]] bool is_open() const;
+
+        /**
+         * @brief get the shared memory descriptor, e.g. to pass it over a unix socket or as "/proc/<pid>/fd/<path>".
+         */
+        [[nodiscard]] int get_path() const;
+
+        /**
+         * @brief publish the input values.
+         *
+         * @param state the input values.
+         */
+        void set_state(const ControllerState& state);
+
+        /**
+         * @brief publish a motion sample.
+         *
+         * @param sample the motion sample.
+         */
+        void set_motion(const MotionSample& sample);
+
+        /**
+         * @brief publish the battery and connection status.
+         *
+         * @param status the status.
+         */
+        void set_status(const SharedStatus& status);
+    };
+
+    /**
+     * @brief SharedReader maps the region of a `SharedWriter` read only, reads never block and never take a lock.
+     */
+    class SharedReader {
+        /**
+         * @brief the mapping.
+         */
+        const SharedRegion* region_ = nullptr;
+
+        /**
+         * @brief map a shared memory object.
+         *
+         * @param path the shared memory object, closed by the caller.
+         */
+        void set_map(int path);
+
+    public:
+        /**
+         * @brief create instance of `SharedReader` for a named region.
+         *
+         * @param name the shared memory name, as passed to the writer.
+         */
+        explicit SharedReader(const std::string& name);
+
+        /**
+         * @brief create instance of `SharedReader` for a shared memory descriptor.
+         *
+         * @param path the descriptor, stays owned by the caller.
+         */
+        explicit SharedReader(int path);
+
+        /**
+         * @brief unmap and destroy instance of `SharedReader`.
+         */
+        ~SharedReader();
+
+        SharedReader(const SharedReader&) = delete;
+        SharedReader& operator=(const SharedReader&) = delete;
+
+        /**
+         * @brief status if the region is mapped and valid.
+         */
+        [[nodiscard]] bool is_open() const;
+
+        /**
+         * @brief get a consistent copy of all input values.
+         *
+         * @return the latest published `ControllerState`.
+         */
+        [[nodiscard]] ControllerState snapshot() const;
+
+        /**
+         * @brief get the latest motion sample, samples published between two calls are skipped.
+         *
+         * @return the latest published `MotionSample`.
+         */
+        [[nodiscard]] MotionSample get_motion() const;
+
+        /**
+         * @brief get the battery and connection status.
+         *
+         * @return the latest published `SharedStatus`.
+         */
+        [[nodiscard]] SharedStatus get_status() const;
+    };
+} // namespace sense
@@ -0,0 +1,208 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Vinzenz Weist
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include "constants.h"
+
+namespace sense {
+    /**
+     * @brief number of buttons reported by the device.
+     */
+    static constexpr std::size_t BUTTON_COUNT = 13;
+
+    /**
+     * @brief number of axis reported by the device.
+     */
+    static constexpr std::size_t AXIS_COUNT = 8;
+
+    /**
+     * @brief ControllerState is a flat, cache-line aligned copy of all input values.
+     */
+    struct alignas(64) ControllerState {
+        /**
+         * @brief button values, indexed by `SenseButtonConstants`.
+         */
+        std::array<int16_t, BUTTON_COUNT> buttons = {};
+
+        /**
+         * @brief axis values, indexed by `SenseAxisConstants`.
+         */
+        std::array<int16_t, AXIS_COUNT> axis = {};
+
+        /**
+         * @brief one bit per pressed button, bit `n` is `SenseButtonConstants` `n`.
+         */
+        uint16_t button_mask = {};
+
+        /**
+         * @brief processed axis values, sticks -1 to 1 and triggers 0 to 1, zero unless processing is enabled.
+         */
+        std::array<float, AXIS_COUNT> normalized = {};
+
+        /**
+         * @brief the device timestamp (`MSC_TIMESTAMP`) of the latest motion report in microseconds, wraps around.
+         */
+        uint32_t device_time = {};
+
+        /**
+         * @brief increments with every published state.
+         */
+        uint64_t sequence = {};
+
+        /**
+         * @brief the kernel time of the latest applied event, the input age is `steady_clock::now() - timestamp`.
+         */
+        std::chrono::steady_clock::time_point timestamp = {};
+
+        /**
+         * @brief get a button value, the index is checked at compile time.
+         *
+         * @tparam BUTTON the button.
+         */
+        template <SenseButtonConstants BUTTON>
+        [[nodiscard]] constexpr int16_t get() const {
+            static_assert(BUTTON < BUTTON_COUNT, "unknown button"); return buttons[BUTTON];
+        }
+
+        /**
+         * @brief get an axis value, the index is checked at compile time.
+         *
+         * @tparam AXIS the axis.
+         */
+        template <SenseAxisConstants AXIS>
+        [[nodiscard]] constexpr int16_t get() const {
+            static_assert(AXIS < AXIS_COUNT, "unknown axis"); return axis[AXIS];
+        }
+
+        /**
+         * @brief get the buttons pressed since a previous state.
+         *
+         * @param previous the previous state.
+         * @return bitmask of buttons which went down.
+         */
+        [[nodiscard]] constexpr uint16_t get_pressed(const ControllerState& previous) const {
+            return (previous.button_mask ^ button_mask) & button_mask;
+        }
+
+        /**
+         * @brief get the buttons released since a previous state.
+         *
+         * @param previous the previous state.
+         * @return bitmask of buttons which went up.
+         */
+        [[nodiscard]] constexpr uint16_t get_released(const ControllerState& previous) const {
+            return (previous.button_mask ^ button_mask) & previous.button_mask;
+        }
+    };
+
+    static_assert(BUTTON_COUNT <= 16, "button_mask holds 16 buttons");
+
+    /**
+     * @brief MotionSample is one complete report of the motion sensors.
+     */
+    struct MotionSample {
+        /**
+         * @brief accelerometer x, y and z, 8192 units per g.
+         */
+        std::array<int32_t, 3> accel = {};
+
+        /**
+         * @brief gyroscope x, y and z, 1024 units per degree per second.
+         */
+        std::array<int32_t, 3> gyro = {};
+
+        /**
+         * @brief the device timestamp (`MSC_TIMESTAMP`) in microseconds, wraps around.
+         */
+        uint32_t device_time = {};
+
+        /**
+         * @brief the kernel time of the `SYN_REPORT` that completed the sample.
+         */
+        std::chrono::steady_clock::time_point timestamp = {};
+    };
+
+    /**
+     * @brief Seqlock publishes a trivially copyable value from a single writer to any number of readers.
+     *
+     * @tparam T the value type.
+     */
+    template <typename T>
+    class Seqlock {
+        static_assert(std::is_trivially_copyable_v<T>, "Seqlock requires a trivially copyable type");
+
+        /**
+         * @brief number of 64 bit words to store the value.
+         */
+        static constexpr std::size_t WORDS = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+        /**
+         * @brief odd while a write is in progress.
+         */
+        alignas(64) std::atomic<uint64_t> sequence_ = {};
+
+        /**
+         * @brief the value, split into atomic words.
+         */
+        std::array<std::atomic<uint64_t>, WORDS> data_ = {};
+
+    public:
+        /**
+         * @brief publish a new value, must only be called from a single writer.
+         *
+         * @param value the value to publish.
+         */
+        void store(const T& value) {
+            std::array<uint64_t, WORDS> words = {}; std::memcpy(words.data(), static_cast<const void*>(&value), sizeof(T));
+            const auto sequence = sequence_.load(std::memory_order::relaxed);
+            sequence_.store(sequence + 1, std::memory_order::relaxed); std::atomic_thread_fence(std::memory_order::release);
+            for (std::size_t i = 0; i < WORDS; ++i) { data_[i].store(words[i], std::memory_order::relaxed); }
+            sequence_.store(sequence + 2, std::memory_order::release);
+        }
+
+        /**
+         * @brief read a consistent copy of the value, never blocks the writer.
+         *
+         * @param retries if set, receives the number of reads that raced a write.
+         * @return the latest published value.
+         */
+        [[nodiscard]] T load(uint64_t* retries = nullptr) const {
+            std::array<uint64_t, WORDS> words = {}; uint64_t count = 0;
+            for (;; ++count) {
+                const auto before = sequence_.load(std::memory_order::acquire);
+                for (std::size_t i = 0; i < WORDS; ++i) { words[i] = data_[i].load(std::memory_order::relaxed); }
+                std::atomic_thread_fence(std::memory_order::acquire);
+                if (before == sequence_.load(std::memory_order::relaxed) && (before & 1) == 0) { break; }
+            }
+            if (retries != nullptr) { *retries = count; } T value; std::memcpy(static_cast<void*>(&value), words.data(), sizeof(T)); return value;
+        }
+    };
+} // namespace sense
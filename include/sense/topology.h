@@ -0,0 +1,120 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Vinzenz Weist
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "device.h"
+
+namespace sense {
+    /**
+     * @brief Topology indexes the nodes of all connected devices, built once from the hid parents in sysfs.
+     */
+    class Topology {
+        /**
+         * @brief the sysfs class directory.
+         */
+        std::string sysfs_root_ = {};
+
+        /**
+         * @brief the directory containing the device nodes.
+         */
+        std::string input_root_ = {};
+
+        /**
+         * @brief guards the index.
+         */
+        mutable std::mutex lock_ = {};
+
+        /**
+         * @brief the paths of each device, ordered by joystick node.
+         */
+        std::vector<DevicePaths> devices_ = {};
+
+        /**
+         * @brief status if the index reflects the connected devices.
+         */
+        bool is_valid_ = {};
+
+        /**
+         * @brief the last key which was not found after a rebuild, it does not trigger another one.
+         */
+        std::string missing_ = {};
+
+        /**
+         * @brief walk sysfs and rebuild the index, the lock must be held.
+         */
+        void set_build();
+
+        /**
+         * @brief find a device in the index, the lock must be held.
+         *
+         * @param key a node or the `uniq` address.
+         * @return the device or nullptr.
+         */
+        const DevicePaths* get_entry(std::string_view key) const;
+
+    public:
+        /**
+         * @brief create instance of `Topology`, the index is built on first use.
+         *
+         * @param sysfs_root the sysfs class directory containing "input", "leds" and "power_supply".
+         * @param input_root the directory containing the device nodes.
+         */
+        explicit Topology(std::string sysfs_root = "/sys/class/", std::string input_root = "/dev/input/");
+
+        /**
+         * @brief get the process-wide index of a sysfs and input root.
+         *
+         * @param sysfs_root the sysfs class directory.
+         * @param input_root the directory containing the device nodes.
+         * @return the shared index.
+         */
+        static std::shared_ptr<Topology> get_shared(const std::string& sysfs_root = "/sys/class/", const std::string& input_root = "/dev/input/");
+
+        /**
+         * @brief get all connected devices.
+         *
+         * @return the paths of each device, ordered by joystick node.
+         */
+        [[nodiscard]] std::vector<DevicePaths> get_devices();
+
+        /**
+         * @brief look up one device, rebuilds if its hid parent is gone or the key is new.
+         *
+         * @param key the joystick, gamepad or motion sensor node, or the `uniq` address.
+         * @return the paths of the device, empty if unknown.
+         */
+        [[nodiscard]] DevicePaths get_device(std::string_view key);
+
+        /**
+         * @brief mark the index as outdated, called on hot-plug.
+         */
+        void set_invalidate();
+    };
+} // namespace sense
@@ -0,0 +1,188 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Vinzenz Weist
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+
+#include "sense/backend.h"
+
+namespace sense {
+    static constexpr int OPEN_FLAGS = O_RDONLY | O_NONBLOCK | O_CLOEXEC;
+
+    /**
+     * @brief events per synthetic packet, a reader never reads more at once.
+     */
+    static constexpr std::size_t PACKET_COUNT = 64;
+
+    Backend::Backend(DevicePaths paths): paths_(std::move(paths)) {}
+
+    Backend::~Backend() = default;
+
+    const DevicePaths& Backend::get_paths() const {
+        return paths_;
+    }
+
+    DevicePaths Backend::get_device() const {
+        return paths_;
+    }
+
+    void Backend::set_invalidate() {}
+
+    EvdevBackend::EvdevBackend(DevicePaths paths, std::string input_root, std::string sysfs_root):
+        Backend(std::move(paths)), input_root_(std::move(input_root)), sysfs_root_(std::move(sysfs_root)), topology_(Topology::get_shared(sysfs_root_, input_root_)) {}
+
+    DevicePaths EvdevBackend::get_device() const {
+        return topology_->get_device(paths_.input.empty() ? paths_.gamepad : paths_.input);
+    }
+
+    void EvdevBackend::set_invalidate() {
+        topology_->set_invalidate();
+    }
+
+    bool EvdevBackend::is_search() const {
+        return topology_->get_devices().empty();
+    }
+
+    int EvdevBackend::set_open(const SenseSourceConstants source) {
+        if (source == SOURCE_INPUT) { return open(paths_.input.c_str(), OPEN_FLAGS); }
+        if (source == SOURCE_GAMEPAD) { return paths_.gamepad.empty() ? -1 : open(paths_.gamepad.c_str(), OPEN_FLAGS); }
+        if (!paths_.sensor.empty()) { return open(paths_.sensor.c_str(), OPEN_FLAGS); }
+        // an indexed device without a sensor node gets it on the next uevent, a search would find the one of another device.
+        if (const auto device = get_device(); !device.hid.empty() || !is_search()) { return device.sensor.empty() ? -1 : open(device.sensor.c_str(), OPEN_FLAGS); }
+
+        // the node names in sysfs identify the sensor without opening unrelated devices.
+        std::error_code error;
+        for (const auto& entry : std::filesystem::directory_iterator(sysfs_root_ + "input/", error)) {
+            const auto name = entry.path().filename().string(); if (!name.starts_with("event")) { continue; }
+            std::ifstream stream(entry.path() / "device" / "name"); std::string line; std::getline(stream, line);
+            if (line.ends_with("Motion Sensors")) { return open((input_root_ + name).c_str(), OPEN_FLAGS); }
+        } if (!error) { return -1; }
+
+        for (const auto& entry : std::filesystem::directory_iterator(input_root_, error)) {
+            if (entry.path().string().find("event") == std::string::npos) { continue; }
+            const int fd = open(entry.path().c_str(), OPEN_FLAGS); if (fd < 0) { continue; }
+            if (char name[256] = {}; ioctl(fd, EVIOCGNAME(sizeof(name)), name) >= 0) {
+                if (std::string(name).find("Motion Sensors") != std::string::npos) { return fd; }
+            } close(fd);
+        } return -1;
+    }
+
+    std::string EvdevBackend::get_led_path() {
+        if (!paths_.led.empty()) { return paths_.led; } if (auto device = get_device(); !device.hid.empty() || !is_search()) { return device.led; } std::error_code error;
+        for (const auto& entry : std::filesystem::directory_iterator(sysfs_root_ + "leds/", error)) {
+            if (entry.is_directory() && entry.path().string().find(":rgb:indicator") != std::string::npos) { return entry.path().string(); }
+        } return {};
+    }
+
+    std::string EvdevBackend::get_battery_path() {
+        if (!paths_.battery.empty()) { return paths_.battery; } if (auto device = get_device(); !device.hid.empty() || !is_search()) { return device.battery; } std::error_code error;
+        for (const auto& entry : std::filesystem::directory_iterator(sysfs_root_ + "power_supply/", error)) {
+            if (entry.is_directory() && entry.path().filename().string().rfind("ps-controller-battery-", 0) == 0) { return entry.path().string(); }
+        } return {};
+    }
+
+    FileBackend::FileBackend(DevicePaths paths): Backend(std::move(paths)) {}
+
+    int FileBackend::set_open(const SenseSourceConstants source) {
+        const auto& path = source == SOURCE_INPUT ? paths_.input : source == SOURCE_GAMEPAD ? paths_.gamepad : paths_.sensor;
+        return path.empty() ? -1 : open(path.c_str(), OPEN_FLAGS);
+    }
+
+    std::string FileBackend::get_led_path() {
+        return paths_.led;
+    }
+
+    std::string FileBackend::get_battery_path() {
+        return paths_.battery;
+    }
+
+    SyntheticBackend::SyntheticBackend(const bool is_gamepad): is_gamepad_(is_gamepad) {
+        std::string root = (std::filesystem::temp_directory_path() / "sense-XXXXXX").string();
+        if (mkdtemp(root.data()) == nullptr) { return; } root_ = root;
+        std::filesystem::create_directory(root_ + "/led"); std::filesystem::create_directory(root_ + "/battery");
+        std::ofstream(root_ + "/led/multi_intensity") << "0 0 0\n"; std::ofstream(root_ + "/led/brightness") << "0\n";
+        set_battery(100);
+    }
+
+    SyntheticBackend::~SyntheticBackend() {
+        set_disconnect(); std::error_code error;
+        if (!root_.empty()) { std::filesystem::remove_all(root_, error); }
+    }
+
+    int SyntheticBackend::set_open(const SenseSourceConstants source) {
+        std::lock_guard lock(lock_); if (!is_available_ || (source != SOURCE_SENSOR && (source == SOURCE_GAMEPAD) != is_gamepad_)) { return -1; }
+        // a packet socket keeps event boundaries and never raises SIGPIPE once the reader is gone.
+        std::array<int, 2> paths = {}; if (socketpair(AF_UNIX, SOCK_SEQPACKET | SOCK_NONBLOCK | SOCK_CLOEXEC, 0, paths.data()) == -1) { return -1; }
+        // a new connection replaces the previous one, its reader sees a disconnect.
+        if (write_paths_[source] != -1) { close(write_paths_[source]); }
+        write_paths_[source] = paths[1]; return paths[0];
+    }
+
+    std::string SyntheticBackend::get_led_path() {
+        return root_.empty() ? std::string() : root_ + "/led";
+    }
+
+    std::string SyntheticBackend::get_battery_path() {
+        return root_.empty() ? std::string() : root_ + "/battery";
+    }
+
+    bool SyntheticBackend::set_events(const std::span<const js_event> events) const {
+        for (std::size_t i = 0; i < events.size(); i += PACKET_COUNT) {
+            const auto packet = events.subspan(i, std::min(PACKET_COUNT, events.size() - i));
+            if (!set_write(SOURCE_INPUT, packet.data(), packet.size_bytes())) { return false; }
+        } return true;
+    }
+
+    bool SyntheticBackend::set_events(const std::span<const input_event> events, const SenseSourceConstants source) const {
+        for (std::size_t i = 0; i < events.size(); i += PACKET_COUNT) {
+            const auto packet = events.subspan(i, std::min(PACKET_COUNT, events.size() - i));
+            if (!set_write(source, packet.data(), packet.size_bytes())) { return false; }
+        } return true;
+    }
+
+    void SyntheticBackend::set_disconnect() {
+        std::lock_guard lock(lock_);
+        for (auto& path : write_paths_) { if (path != -1) { close(path); path = -1; } }
+    }
+
+    void SyntheticBackend::set_available(const bool enable) {
+        std::lock_guard lock(lock_); is_available_ = enable;
+    }
+
+    void SyntheticBackend::set_battery(const uint8_t capacity, const std::string& status) const {
+        if (root_.empty()) { return; }
+        std::ofstream(root_ + "/battery/capacity") << static_cast<int>(capacity) << "\n";
+        std::ofstream(root_ + "/battery/status") << status << "\n";
+    }
+
+    bool SyntheticBackend::set_write(const SenseSourceConstants source, const void* data, const std::size_t size) const {
+        std::lock_guard lock(lock_); if (write_paths_[source] == -1) { return false; }
+        return send(write_paths_[source], data, size, MSG_NOSIGNAL) == static_cast<ssize_t>(size);
+    }
+} // namespace sense
@@ -0,0 +1,179 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Vinzenz Weist
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <cerrno>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+#include "sense/capture.h"
+
+namespace sense {
+    static constexpr auto STD_MEMORY_ORDER = std::memory_order::relaxed;
+
+    CaptureWriter::CaptureWriter(const std::string& path): path_(open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644)) {
+        if (struct stat info = {}; path_ != -1 && fstat(path_, &info) == 0 && info.st_size == 0) {
+            CaptureHeader header = {}; header.record_size = sizeof(CaptureRecord);
+            if (write(path_, &header, sizeof(header)) != sizeof(header)) { close(path_); path_ = -1; }
+        }
+    }
+
+    CaptureWriter::~CaptureWriter() {
+        set_flush(); if (path_ != -1) { close(path_); }
+    }
+
+    bool CaptureWriter::is_open() const {
+        return path_ != -1;
+    }
+
+    void CaptureWriter::set_record(const CaptureRecord& record) {
+        buffer_[count_++] = record; if (count_ == buffer_.size()) { set_flush(); }
+    }
+
+    void CaptureWriter::set_record(const std::span<const js_event> events, const int64_t time) {
+        for (const auto& event : events) {
+            set_record({ time, static_cast<int64_t>(event.time) * 1000000, event.type, event.number, event.value, SOURCE_INPUT });
+        }
+    }
+
+    void CaptureWriter::set_record(const std::span<const input_event> events, const int64_t time, const SenseSourceConstants source) {
+        for (const auto& event : events) {
+            const auto event_time = static_cast<int64_t>(event.input_event_sec) * 1000000000 + static_cast<int64_t>(event.input_event_usec) * 1000;
+            set_record({ time, event_time, event.type, event.code, event.value, source });
+        }
+    }
+
+    void CaptureWriter::set_flush() {
+        if (path_ != -1 && count_ != 0) { [[maybe_unused]] const auto bytes = write(path_, buffer_.data(), count_ * sizeof(CaptureRecord)); }
+        count_ = 0;
+    }
+
+    CaptureReader::CaptureReader(const std::string& path) {
+        const int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC); if (fd == -1) { return; }
+        if (struct stat info = {}; fstat(fd, &info) == 0 && static_cast<std::size_t>(info.st_size) >= sizeof(CaptureHeader)) {
+            size_ = static_cast<std::size_t>(info.st_size);
+            if (data_ = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0); data_ == MAP_FAILED) { data_ = nullptr; size_ = 0; }
+        } close(fd); if (data_ == nullptr) { return; }
+
+        CaptureHeader header = {}; std::memcpy(&header, data_, sizeof(header));
+        if (header.magic != CaptureHeader().magic || header.version != CaptureHeader().version || header.record_size != sizeof(CaptureRecord)) { return; }
+        madvise(data_, size_, MADV_SEQUENTIAL);
+        // a partially written record at the end is ignored.
+        records_ = { reinterpret_cast<const CaptureRecord*>(static_cast<const char*>(data_) + sizeof(CaptureHeader)), (size_ - sizeof(CaptureHeader)) / sizeof(CaptureRecord) };
+    }
+
+    CaptureReader::~CaptureReader() {
+        if (data_ != nullptr) { munmap(data_, size_); }
+    }
+
+    bool CaptureReader::is_open() const {
+        return data_ != nullptr && records_.data() != nullptr;
+    }
+
+    std::span<const CaptureRecord> CaptureReader::get_records() const {
+        return records_;
+    }
+
+    Replay::Replay(const CaptureReader& reader, const bool is_realtime): records_(reader.get_records()), is_realtime_(is_realtime), wake_path_(eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)) {
+        is_gamepad_ = std::ranges::any_of(records_, [](const auto& record) { return record.source == SOURCE_GAMEPAD; });
+        for (std::size_t i = 0; i < read_paths_.size(); ++i) {
+            if (std::array<int, 2> paths = {}; pipe2(paths.data(), O_CLOEXEC) == 0) {
+                read_paths_[i] = paths[0]; write_paths_[i] = paths[1];
+                fcntl(write_paths_[i], F_SETFL, O_NONBLOCK); fcntl(write_paths_[i], F_SETPIPE_SZ, 1 << 20);
+            }
+        }
+    }
+
+    Replay::~Replay() {
+        set_stop();
+        for (auto* paths : { &read_paths_, &write_paths_ }) { for (const auto path : *paths) { if (path != -1) { close(path); } } }
+        if (wake_path_ != -1) { close(wake_path_); }
+    }
+
+    DevicePaths Replay::get_paths() const {
+        return { .input = "/proc/self/fd/" + std::to_string(read_paths_[0]), .gamepad = is_gamepad_ ? "/proc/self/fd/" + std::to_string(read_paths_[2]) : std::string(),
+                 .sensor = "/proc/self/fd/" + std::to_string(read_paths_[1]) };
+    }
+
+    bool Replay::set_start() {
+        if (thread_.joinable() || wake_path_ == -1 || std::ranges::find(write_paths_, -1) != write_paths_.end()) { return false; }
+        thread_ = std::thread([this] {
+            std::array<js_event, 64> js_events = {}; std::array<std::array<input_event, 64>, 2> io_events = {}; std::array<std::size_t, 3> counts = {};
+            const auto set_flush = [&] {
+                auto is_written = set_write(write_paths_[SOURCE_INPUT], js_events.data(), counts[SOURCE_INPUT] * sizeof(js_event));
+                for (const auto source : { SOURCE_SENSOR, SOURCE_GAMEPAD }) { is_written = is_written && set_write(write_paths_[source], io_events[source - 1].data(), counts[source] * sizeof(input_event)); }
+                counts = {}; return is_written;
+            };
+
+            const auto start = std::chrono::steady_clock::now(); const auto first = records_.empty() ? 0 : records_.front().time;
+            for (const auto& record : records_) {
+                if (is_terminated_.load(STD_MEMORY_ORDER)) { break; }
+                if (is_realtime_ && !set_wait(start + std::chrono::nanoseconds(record.time - first))) { break; }
+                if (record.source > SOURCE_GAMEPAD) { continue; }
+                if (record.source == SOURCE_INPUT) {
+                    js_events[counts[SOURCE_INPUT]++] = { static_cast<uint32_t>(record.event_time / 1000000), static_cast<int16_t>(record.value), static_cast<uint8_t>(record.type), static_cast<uint8_t>(record.code) };
+                } else {
+                    auto& event = io_events[record.source - 1][counts[record.source]++]; event.type = record.type; event.code = record.code; event.value = record.value;
+                    event.input_event_sec = record.event_time / 1000000000; event.input_event_usec = record.event_time % 1000000000 / 1000;
+                }
+                if ((is_realtime_ || counts[record.source] == js_events.size()) && !set_flush()) { break; }
+            }
+            // closing the write ends signals the end of the replay to the reader.
+            set_flush(); for (auto& path : write_paths_) { close(path); path = -1; } is_finished_.store(true, STD_MEMORY_ORDER);
+        });
+        return true;
+    }
+
+    void Replay::set_stop() {
+        is_terminated_.store(true, STD_MEMORY_ORDER);
+        if (wake_path_ != -1) { constexpr uint64_t value = 1; [[maybe_unused]] const auto bytes = write(wake_path_, &value, sizeof(value)); }
+        if (thread_.joinable()) { thread_.join(); }
+    }
+
+    bool Replay::is_finished() const {
+        return is_finished_.load(STD_MEMORY_ORDER);
+    }
+
+    bool Replay::set_write(const int path, const void* data, std::size_t size) const {
+        while (size != 0 && !is_terminated_.load(STD_MEMORY_ORDER)) {
+            if (const ssize_t bytes = write(path, data, size); bytes > 0) { data = static_cast<const char*>(data) + bytes; size -= static_cast<std::size_t>(bytes); continue; }
+            if (errno != EAGAIN) { return false; }
+            std::array<pollfd, 2> poll_paths = {{ { path, POLLOUT, 0 }, { wake_path_, POLLIN, 0 } }}; poll(poll_paths.data(), poll_paths.size(), -1);
+        } return size == 0;
+    }
+
+    bool Replay::set_wait(const std::chrono::steady_clock::time_point deadline) const {
+        // the wake eventfd stays readable once stopped, every later wait returns immediately.
+        while (!is_terminated_.load(STD_MEMORY_ORDER)) {
+            const auto remaining = std::chrono::duration_cast<std::chrono::nanoseconds>(deadline - std::chrono::steady_clock::now()).count(); if (remaining <= 0) { return true; }
+            pollfd poll_path = { wake_path_, POLLIN, 0 }; const timespec timeout = { remaining / 1000000000, remaining % 1000000000 }; ppoll(&poll_path, 1, &timeout, nullptr);
+        } return false;
+    }
+} // namespace sense
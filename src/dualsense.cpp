@@ -22,142 +22,454 @@
  * SOFTWARE.
  */
 
+#include <cerrno>
+#include <ctime>
 #include <fcntl.h>
 #include <unistd.h>
-#include <filesystem>
+#include <sys/ioctl.h>
+#include <sys/timerfd.h>
+#include <algorithm>
+#include <charconv>
+#include <cstdlib>
 #include <iostream>
-#include <mutex>
 
 #include "sense/dualsense.h"
 
 namespace sense {
     static constexpr auto STD_MEMORY_ORDER = std::memory_order::relaxed;
 
-    DualSense::DualSense(const char* path, const uint16_t timeout): device_path_(path), timeout_(timeout) {
+    /**
+     * @brief marks a gamepad code without a button or axis.
+     */
+    static constexpr uint8_t UNMAPPED = 0xff;
+
+    /**
+     * @brief maps `EV_KEY` codes, offset by `BTN_SOUTH`, onto `SenseButtonConstants`.
+     */
+    static constexpr auto KEY_MAP = [] {
+        std::array<uint8_t, BTN_THUMBR - BTN_SOUTH + 1> map = {}; map.fill(UNMAPPED);
+        map[BTN_SOUTH - BTN_SOUTH] = BUTTON_CROSS; map[BTN_EAST - BTN_SOUTH] = BUTTON_CIRCLE; map[BTN_NORTH - BTN_SOUTH] = BUTTON_TRIANGLE; map[BTN_WEST - BTN_SOUTH] = BUTTON_SQUARE;
+        map[BTN_TL - BTN_SOUTH] = BUTTON_SHOULDER_LEFT; map[BTN_TR - BTN_SOUTH] = BUTTON_SHOULDER_RIGHT; map[BTN_TL2 - BTN_SOUTH] = BUTTON_TRIGGER_LEFT; map[BTN_TR2 - BTN_SOUTH] = BUTTON_TRIGGER_RIGHT;
+        map[BTN_SELECT - BTN_SOUTH] = BUTTON_SHARE; map[BTN_START - BTN_SOUTH] = BUTTON_OPTIONS; map[BTN_MODE - BTN_SOUTH] = BUTTON_PS;
+        map[BTN_THUMBL - BTN_SOUTH] = BUTTON_THUMB_LEFT; map[BTN_THUMBR - BTN_SOUTH] = BUTTON_THUMB_RIGHT;
+        return map;
+    }();
+
+    /**
+     * @brief maps `EV_ABS` codes onto `SenseAxisConstants`.
+     */
+    static constexpr auto ABS_MAP = [] {
+        std::array<uint8_t, ABS_HAT0Y + 1> map = {}; map.fill(UNMAPPED);
+        map[ABS_X] = AXIS_LEFT_THUMB_X; map[ABS_Y] = AXIS_LEFT_THUMB_Y; map[ABS_Z] = AXIS_LEFT_TRIGGER;
+        map[ABS_RX] = AXIS_RIGHT_THUMB_X; map[ABS_RY] = AXIS_RIGHT_THUMB_Y; map[ABS_RZ] = AXIS_RIGHT_TRIGGER;
+        map[ABS_HAT0X] = AXIS_D_PAD_LEFT_RIGHT; map[ABS_HAT0Y] = AXIS_D_PAD_UP_DOWN;
+        return map;
+    }();
+
+    /**
+     * @brief scale an evdev axis value onto the joydev range.
+     *
+     * @param range the minimum and maximum of the axis, passed through if empty.
+     * @param value the evdev value.
+     * @return the value between -32767 and 32767.
+     */
+    static int16_t get_scaled(const std::array<int32_t, 2>& range, const int32_t value) {
+        const auto scaled = range[1] > range[0] ? (static_cast<int64_t>(value) - range[0]) * 65534 / (static_cast<int64_t>(range[1]) - range[0]) - 32767 : static_cast<int64_t>(value);
+        return static_cast<int16_t>(std::clamp<int64_t>(scaled, -32767, 32767));
+    }
+
+    /**
+     * @brief check if a uevent belongs to a device, by its node name or its hid parent.
+     *
+     * @param paths the nodes of the device.
+     * @param event the uevent.
+     * @return bool indicates the event reports a node of the device.
+     */
+    static bool is_device(const DevicePaths& paths, const HotplugEvent& event) {
+        const auto get_name = [](const std::string_view path) { return path.substr(path.rfind('/') + 1); }; const auto name = get_name(event.name);
+        if (std::ranges::any_of(std::array{ &paths.input, &paths.gamepad, &paths.sensor }, [&](const auto* path) { return !path->empty() && get_name(*path) == name; })) { return true; }
+        // a node which appears later, e.g. the motion sensor, sits below the same hid parent.
+        return !paths.hid.empty() && event.path.find("/" + std::string(get_name(paths.hid)) + "/") != std::string_view::npos;
+    }
+
+    DualSense::DualSense(const char* path, const uint16_t timeout): DualSense(std::make_shared<Reactor>(), DevicePaths{ .input = path }, timeout) {}
+
+    DualSense::DualSense(std::shared_ptr<Reactor> reactor, DevicePaths paths, const uint16_t timeout, Seqlock<ControllerState>* snapshot):
+        DualSense(std::move(reactor), std::make_shared<EvdevBackend>(std::move(paths)), timeout, snapshot) {}
+
+    DualSense::DualSense(std::shared_ptr<Reactor> reactor, std::shared_ptr<Backend> backend, const uint16_t timeout, Seqlock<ControllerState>* snapshot):
+        backend_(std::move(backend)), timeout_(timeout), reactor_(std::move(reactor)), snapshot_(snapshot != nullptr ? snapshot : &storage_) {
         reset_input();
     }
 
-    DualSense::~DualSense() { set_close(); }
+    DualSense::~DualSense() { hotplug_.reset(); set_close(); }
 
     void DualSense::reset_input() {
-        buttons_ = {
-            { BUTTON_CROSS, 0 }, { BUTTON_CIRCLE, 0 }, { BUTTON_TRIANGLE, 0 }, { BUTTON_SQUARE, 0 },
-            { BUTTON_SHOULDER_LEFT, 0 }, { BUTTON_SHOULDER_RIGHT, 0 }, { BUTTON_TRIGGER_LEFT, 0 }, { BUTTON_TRIGGER_RIGHT, 0 },
-            { BUTTON_SHARE, 0 }, { BUTTON_OPTIONS, 0 }, { BUTTON_PS, 0 }, { BUTTON_THUMB_LEFT, 0 }, { BUTTON_THUMB_RIGHT, 0 }
-        };
-        axis_ = {
-            { AXIS_LEFT_THUMB_X, 0 }, { AXIS_LEFT_THUMB_Y, 0 }, { AXIS_LEFT_TRIGGER, -32767 },
-            { AXIS_RIGHT_THUMB_X, 0 }, { AXIS_RIGHT_THUMB_Y, 0 }, { AXIS_RIGHT_TRIGGER, -32767 },
-            { AXIS_D_PAD_LEFT_RIGHT, 0 }, { AXIS_D_PAD_UP_DOWN, 0 }
-        };
+        const auto buttons = state_.buttons; const auto axis = state_.axis; state_.buttons = {}; state_.axis = {}; state_.button_mask = 0;
+        state_.axis[AXIS_LEFT_TRIGGER] = -32767; state_.axis[AXIS_RIGHT_TRIGGER] = -32767; state_.timestamp = std::chrono::steady_clock::now();
+        // the history sees the defaults as regular changes, a disconnect releases every held button.
+        for (uint8_t i = 0; history_ != nullptr && i < BUTTON_COUNT; ++i) { if (buttons[i] != 0) { history_->set_event({ EVENT_BUTTON_RELEASE, i, 0, state_.timestamp }); } }
+        for (uint8_t i = 0; history_ != nullptr && i < AXIS_COUNT; ++i) { if (axis[i] != state_.axis[i]) { history_->set_event({ EVENT_AXIS, i, state_.axis[i], state_.timestamp }); } }
+        set_publish();
+    }
+
+    void DualSense::set_publish() {
+        if (is_processing_) { processor_.get_axis(state_.axis, state_.normalized); }
+        state_.sequence++; snapshot_->store(state_); if (shared_ != nullptr) { shared_->set_state(state_); }
     }
 
     bool DualSense::set_open() {
-        is_terminated_.store(false, STD_MEMORY_ORDER); js_event_path_.store(open(device_path_, O_RDONLY), STD_MEMORY_ORDER);
-        if (timeout_ != 0) { io_event_path_.store(open(get_sensor_path().c_str(), O_RDONLY), STD_MEMORY_ORDER); }
-        if (js_event_path_.load(STD_MEMORY_ORDER) != -1) { this->set_input_thread(); is_active_.store(true, STD_MEMORY_ORDER); }
-        if (io_event_path_.load(STD_MEMORY_ORDER) != -1 && timeout_ != 0) { this->set_timestamp_thread(); this->set_timeout_thread(); }
-        return js_event_path_.load(STD_MEMORY_ORDER) != -1 && io_event_path_.load(STD_MEMORY_ORDER) != -1;
+        return reactor_->set_invoke([this] {
+            // evdev stamps events with the realtime clock by default, switch to the steady clock. other sources keep receive times.
+            const auto set_clock = [this](const int path, const SenseSourceConstants source) { int clock = CLOCK_MONOTONIC; is_kernel_time_[source] = path != -1 && ioctl(path, EVIOCSCLOCKID, &clock) == 0; };
+            const auto was_inactive = !is_active_.load(STD_MEMORY_ORDER);
+            if (was_inactive) {
+                js_event_path_ = backend_->set_open(SOURCE_GAMEPAD); is_gamepad_ = js_event_path_ != -1; set_clock(js_event_path_, SOURCE_GAMEPAD);
+                if (!is_gamepad_) { js_event_path_ = backend_->set_open(SOURCE_INPUT); if (js_event_path_ == -1) { return false; } }
+                // the gamepad node reports its current state, it replaces the defaults without dispatching edges.
+                if (is_gamepad_) { receipt_ = std::chrono::steady_clock::now(); ranges_ = {}; is_input_dropped_ = false; if (set_sync()) { set_publish(); } pending_count_ = 0; }
+                watches_[0] = reactor_->set_watch(js_event_path_, [this] { is_gamepad_ ? set_gamepad_event() : set_input_event(); }); is_active_.store(true, STD_MEMORY_ORDER); set_count(lifecycle_counters_[0]);
+            }
+            // the motion sensor node may appear after the input node, a later call opens it.
+            if (timeout_ != 0 && io_event_path_ == -1 && (io_event_path_ = backend_->set_open(SOURCE_SENSOR)) != -1) {
+                set_clock(io_event_path_, SOURCE_SENSOR); timer_path_ = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC); current_time_ = std::chrono::steady_clock::now(); device_receipt_ = {};
+                watches_[1] = reactor_->set_watch(io_event_path_, [this] { set_sensor_event(); });
+                watches_[2] = reactor_->set_watch(timer_path_, [this] { set_timeout_event(); });
+                set_timeout(current_time_ + std::chrono::milliseconds(std::max(static_cast<uint16_t>(100), timeout_)));
+            }
+            // the led paths are opened by the next write, the reactor never waits for a writer.
+            if (was_inactive) { { std::lock_guard lock(battery_lock_); set_battery(); } set_notify(EVENT_CONNECT); set_status(); }
+            return timeout_ == 0 || io_event_path_ != -1;
+        });
     }
 
     bool DualSense::set_close() {
-        is_terminated_.store(true, STD_MEMORY_ORDER);
-        for (auto &thread : thread_pool_) { if (thread.joinable()) { thread.join(); } }
-        is_active_.store(false, STD_MEMORY_ORDER); thread_pool_ = {}; reset_input();
-        return close(js_event_path_.load(STD_MEMORY_ORDER)) != -1 && close(io_event_path_.load(STD_MEMORY_ORDER)) != -1;
+        return reactor_->set_invoke([this] {
+            for (auto& watch : watches_) { reactor_->set_unwatch(watch); watch = -1; }
+            if (is_active_.exchange(false, STD_MEMORY_ORDER)) { reset_input(); set_count(lifecycle_counters_[1]); set_notify(EVENT_DISCONNECT); set_status(); } auto result = true;
+            for (auto* path : { &js_event_path_, &io_event_path_, &timer_path_ }) { if (*path != -1) { result &= close(*path) != -1; *path = -1; } }
+            led_generation_.fetch_add(1, STD_MEMORY_ORDER); std::lock_guard lock(battery_lock_); battery_.set_close(); return result;
+        });
     }
 
     bool DualSense::is_active() const {
         return is_active_.load(STD_MEMORY_ORDER);
     }
 
+    DevicePaths DualSense::get_paths() const {
+        return reactor_->set_invoke([this] { return backend_->get_paths(); });
+    }
+
+    DevicePaths DualSense::get_device_paths() const {
+        const auto backend = get_backend(); auto paths = backend->get_paths(); const auto device = backend->get_device();
+        for (auto [path, found] : { std::pair{ &paths.input, &device.input }, { &paths.gamepad, &device.gamepad }, { &paths.sensor, &device.sensor }, { &paths.led, &device.led },
+                                    { &paths.battery, &device.battery }, { &paths.hid, &device.hid }, { &paths.uniq, &device.uniq } }) { if (path->empty()) { *path = *found; } }
+        return paths;
+    }
+
+    void DualSense::set_backend(std::shared_ptr<Backend> backend) {
+        reactor_->set_invoke([this, &backend] {
+            // other threads copy the backend before a lookup, the swap never waits for a led write.
+            set_close(); std::lock_guard lock(backend_lock_); backend_ = std::move(backend);
+        });
+    }
+
     void DualSense::set_logging(const bool enable) {
         is_log_ = enable;
     }
 
+    ControllerState DualSense::snapshot() const {
+        uint64_t retries = 0; const auto state = snapshot_->load(&retries);
+        if (retries != 0) { snapshot_retries_.fetch_add(retries, STD_MEMORY_ORDER); } return state;
+    }
+
+    Metrics DualSense::get_metrics() const {
+        Metrics metrics = {}; std::array paths = { &metrics.input, &metrics.sensor };
+        for (std::size_t i = 0; i < paths.size(); ++i) {
+            *paths[i] = { path_counters_[i].reads.load(STD_MEMORY_ORDER), path_counters_[i].events.load(STD_MEMORY_ORDER), path_counters_[i].bytes.load(STD_MEMORY_ORDER),
+                          path_counters_[i].last.load(STD_MEMORY_ORDER), path_counters_[i].max.load(STD_MEMORY_ORDER) };
+        }
+        metrics.snapshot_retries = snapshot_retries_.load(STD_MEMORY_ORDER); metrics.motion_dropped = motion_dropped_.load(STD_MEMORY_ORDER);
+        metrics.opens = lifecycle_counters_[0].load(STD_MEMORY_ORDER); metrics.closes = lifecycle_counters_[1].load(STD_MEMORY_ORDER); metrics.timeouts = lifecycle_counters_[2].load(STD_MEMORY_ORDER);
+        metrics.receive_latency = receive_latency_.get_snapshot(); metrics.busy_latency = wake_latency_[0].get_snapshot(); metrics.sleep_latency = wake_latency_[1].get_snapshot();
+        metrics.device_jitter = device_jitter_.get_snapshot(); metrics.led_latency = led_latency_.get_snapshot();
+        return metrics;
+    }
+
+    std::size_t DualSense::get_motion(const std::span<MotionSample> samples) {
+        return motion_.pop(samples);
+    }
+
+    void DualSense::set_capture(CaptureWriter* writer) {
+        reactor_->set_invoke([this, writer] { capture_ = writer; });
+    }
+
+    void DualSense::set_shared(SharedWriter* writer) {
+        reactor_->set_invoke([this, writer] { shared_ = writer; if (shared_ != nullptr) { shared_->set_state(snapshot_->load()); set_status(); } });
+    }
+
+    void DualSense::set_history(History* history) {
+        reactor_->set_invoke([this, history] { history_ = history; });
+    }
+
+    void DualSense::set_processing(const bool enable, const InputProfile& profile) {
+        reactor_->set_invoke([this, enable, &profile] {
+            processor_ = Processor(profile); is_processing_ = enable;
+            if (!enable) { state_.normalized = {}; } set_publish();
+        });
+    }
+
+    bool DualSense::set_reconnect(const bool enable) {
+        if (!enable) { hotplug_.reset(); return true; } if (hotplug_) { return hotplug_->is_open(); }
+        // opening is a no-op while active, except for a motion sensor which appeared later.
+        hotplug_ = std::make_unique<Hotplug>(reactor_, [](const HotplugEvent& event, void* context) {
+            if (event.action == HOTPLUG_REMOVE) { return; } auto* sense = static_cast<DualSense*>(context); sense->backend_->set_invalidate();
+            if (is_device(sense->get_device_paths(), event)) { sense->set_open(); }
+        }, this);
+        return hotplug_->is_open();
+    }
+
+    bool DualSense::set_scheduling(const SchedulingOptions& options) {
+        return reactor_->set_scheduling(options);
+    }
+
+    int DualSense::set_subscribe(const SenseCallback callback, void* context, const uint8_t events, const uint16_t threshold) {
+        return observer_.set_subscribe(callback, context, events, threshold);
+    }
+
+    void DualSense::set_unsubscribe(const int id) {
+        observer_.set_unsubscribe(id);
+    }
+
     std::map<SenseButtonConstants, int16_t> DualSense::get_buttons() {
-        std::lock_guard lock(mutex_lock_); return buttons_;
+        const auto state = snapshot(); std::map<SenseButtonConstants, int16_t> buttons;
+        for (uint8_t i = 0; i < BUTTON_COUNT; ++i) { buttons[static_cast<SenseButtonConstants>(i)] = state.buttons[i]; }
+        return buttons;
     }
 
     std::map<SenseAxisConstants, int16_t> DualSense::get_axis() {
-        std::lock_guard lock(mutex_lock_); return axis_;
+        const auto state = snapshot(); std::map<SenseAxisConstants, int16_t> axis;
+        for (uint8_t i = 0; i < AXIS_COUNT; ++i) { axis[static_cast<SenseAxisConstants>(i)] = state.axis[i]; }
+        return axis;
     }
 
     void DualSense::set_led(const uint8_t red, const uint8_t green, const uint8_t blue, const uint8_t brightness) {
-        std::string rgb_path; std::string brightness_path; bool device_found = false;
+        std::lock_guard lock(sysfs_lock_); set_sysfs();
+        if (!pathfinder_.is_open(PATH_LED_RGB)) { if (is_log_) { std::printf("[Sense]: error, no valid rgb device found.\n"); } return; }
 
-        for (const auto& entry : std::filesystem::directory_iterator("/sys/class/leds/")) {
-            if (entry.is_directory() && entry.path().string().find(":rgb:indicator") != std::string::npos) {
-                rgb_path = entry.path().string() + "/multi_intensity";
-                brightness_path = entry.path().string() + "/brightness";
-                device_found = true; break;
-            }
+        // both values are written back to back, unchanged values are skipped.
+        const auto start = std::chrono::steady_clock::now(); auto is_written = false;
+        if (const std::array<int, 3> rgb = { red, green, blue }; !std::equal(rgb.begin(), rgb.end(), led_values_.begin())) {
+            std::array<char, 16> buffer = {}; auto* end = buffer.data();
+            for (const auto value : rgb) { end = std::to_chars(end, buffer.data() + buffer.size(), value).ptr; *end++ = ' '; }
+            if (pathfinder_.set_value(PATH_LED_RGB, std::string_view(buffer.data(), end - buffer.data() - 1))) { std::copy(rgb.begin(), rgb.end(), led_values_.begin()); } is_written = true;
         }
-
-        if (!device_found) { if (is_log_) { std::printf("[Sense]: error, no valid rgb device found.\n"); } return; }
-        const std::string values = std::to_string(red) + " " + std::to_string(green) + " " + std::to_string(blue);
-        pathfinder_.set_value(rgb_path, values); pathfinder_.set_value(brightness_path, std::to_string(brightness));
+        if (brightness != led_values_[3]) {
+            std::array<char, 4> buffer = {}; const auto* end = std::to_chars(buffer.data(), buffer.data() + buffer.size(), brightness).ptr;
+            if (pathfinder_.set_value(PATH_LED_BRIGHTNESS, std::string_view(buffer.data(), end - buffer.data()))) { led_values_[3] = brightness; } is_written = true;
+        }
+        if (is_written) { led_latency_.set_value(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count()); }
     }
 
     std::map<SenseStatusConstants, std::string> DualSense::get_device_info() {
+        std::lock_guard lock(battery_lock_); set_battery(); std::array<char, 32> buffer = {};
         std::map<SenseStatusConstants, std::string> device_info = { { STATUS, "" }, { CAPACITY, "" } };
+        device_info[STATUS] = battery_.get_value(PATH_BATTERY_STATUS, buffer);
+        device_info[CAPACITY] = battery_.get_value(PATH_BATTERY_CAPACITY, buffer);
+        return device_info;
+    }
 
-        for (const std::string power_supply_path = "/sys/class/power_supply/"; const auto& entry : std::filesystem::directory_iterator(power_supply_path)) {
-            if (entry.is_directory() && entry.path().filename().string().rfind("ps-controller-battery-", 0) == 0) {
-                const std::string path = entry.path().string();
-                device_info[STATUS] = pathfinder_.get_value(path + "/status");
-                device_info[CAPACITY] = pathfinder_.get_value(path + "/capacity"); break;
-            }
-        } return device_info;
+    int DualSense::get_capacity() {
+        std::lock_guard lock(battery_lock_); set_battery(); return get_battery();
     }
 
-    std::string DualSense::get_sensor_path() {
-        const std::string target = "Motion Sensors";
+    int DualSense::get_battery() {
+        std::array<char, 8> buffer = {}; const auto value = battery_.get_value(PATH_BATTERY_CAPACITY, buffer); auto capacity = -1;
+        std::from_chars(value.data(), value.data() + value.size(), capacity); return capacity;
+    }
 
-        for (const auto &entry : std::filesystem::directory_iterator("/dev/input/")) {
-            if (entry.path().string().find("event") == std::string::npos) { continue; }
-            const int fd = open(entry.path().c_str(), O_RDONLY); if (fd < 0) { continue; }
-            if (char name[256] = {}; ioctl(fd, EVIOCGNAME(sizeof(name)), name) >= 0) {
-                if (std::string(name).find(target) != std::string::npos) { close(fd); return entry.path().string(); }
-            } close(fd);
-        } return {};
+    std::shared_ptr<Backend> DualSense::get_backend() const {
+        std::lock_guard lock(backend_lock_); return backend_;
     }
 
-    void DualSense::set_input_thread() {
-        thread_pool_[0] = std::thread([this] {
-            while (!is_terminated_.load(STD_MEMORY_ORDER)) {
-                if (const ssize_t bytes = read(js_event_path_.load(STD_MEMORY_ORDER), &js_event_, sizeof(js_event_)); bytes == sizeof(js_event_)) {
-                    std::lock_guard lock(mutex_lock_);
-                    if (js_event_.type == JS_EVENT_BUTTON) { buttons_[static_cast<SenseButtonConstants>(js_event_.number)] = js_event_.value; }
-                    if (js_event_.type == JS_EVENT_AXIS) { axis_[static_cast<SenseAxisConstants>(js_event_.number)] = js_event_.value; }
-                } else { if (is_log_) { std::printf("[Sense]: error during read, terminating.\n"); } set_close(); break; }
+    void DualSense::set_sysfs() {
+        if (const auto generation = led_generation_.load(STD_MEMORY_ORDER); generation != led_opened_) { pathfinder_.set_close(); led_opened_ = generation; }
+        if (!pathfinder_.is_open(PATH_LED_RGB)) {
+            if (const auto led_path = get_backend()->get_led_path(); !led_path.empty()) {
+                pathfinder_.set_open(PATH_LED_RGB, led_path + "/multi_intensity", O_WRONLY);
+                pathfinder_.set_open(PATH_LED_BRIGHTNESS, led_path + "/brightness", O_WRONLY); led_values_.fill(-1);
             }
-        });
-        thread_pool_[0].detach();
+        }
     }
 
-    void DualSense::set_timestamp_thread() {
-        current_time_.store(std::chrono::high_resolution_clock::now(), STD_MEMORY_ORDER);
-        thread_pool_[1] = std::thread([this] {
-            while (!is_terminated_.load(STD_MEMORY_ORDER)) {
-                if (const ssize_t bytes = read(io_event_path_.load(STD_MEMORY_ORDER), &io_event_, sizeof(io_event_)); bytes == sizeof(io_event_)) {
-                    if (io_event_.type != EV_MSC || io_event_.code != MSC_TIMESTAMP) { continue; }
-                    current_time_.store(std::chrono::high_resolution_clock::now(), STD_MEMORY_ORDER);
-                }
+    void DualSense::set_battery() {
+        if (!battery_.is_open(PATH_BATTERY_CAPACITY)) {
+            if (const auto battery_path = get_backend()->get_battery_path(); !battery_path.empty()) {
+                battery_.set_open(PATH_BATTERY_STATUS, battery_path + "/status", O_RDONLY);
+                battery_.set_open(PATH_BATTERY_CAPACITY, battery_path + "/capacity", O_RDONLY);
             }
-        });
-        thread_pool_[1].detach();
+        }
     }
 
-    void DualSense::set_timeout_thread() {
-        thread_pool_[2] = std::thread([this] {
-            const auto timeout = std::max(static_cast<uint16_t>(100), timeout_);
-            while (!is_terminated_.load(STD_MEMORY_ORDER)) {
-                if (std::chrono::high_resolution_clock::now() >= current_time_.load(STD_MEMORY_ORDER) + std::chrono::milliseconds(timeout)) {
-                    if (is_log_) { std::printf("[Sense]: error, run into timeout.\n"); } this->set_close();
-                } std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    void DualSense::set_input_event() {
+        while (true) {
+            const ssize_t bytes = read(js_event_path_, js_events_.data(), sizeof(js_events_));
+            if (bytes == -1 && errno == EAGAIN) { break; }
+            if (bytes <= 0 || bytes % sizeof(js_event) != 0) { if (is_log_) { std::printf("[Sense]: error during read, terminating.\n"); } set_close(); break; }
+            const auto count = static_cast<std::size_t>(bytes) / sizeof(js_event); set_batch(path_counters_[0], count, bytes); receipt_ = std::chrono::steady_clock::now();
+            if (capture_ != nullptr) { capture_->set_record(std::span(js_events_.data(), count), std::chrono::duration_cast<std::chrono::nanoseconds>(receipt_.time_since_epoch()).count()); }
+            auto is_changed = false; for (std::size_t i = 0; i < count; ++i) { is_changed |= set_input(js_events_[i]); }
+            if (is_changed) { set_publish(); }
+            for (std::size_t i = 0; i < pending_count_; ++i) { observer_.set_dispatch(pending_[i]); }
+            pending_count_ = 0; if (count < js_events_.size()) { break; }
+        }
+    }
+
+    void DualSense::set_sensor_event() {
+        while (true) {
+            const ssize_t bytes = read(io_event_path_, io_events_.data(), sizeof(io_events_));
+            if (bytes == -1 && errno == EAGAIN) { break; }
+            if (bytes <= 0 || bytes % sizeof(input_event) != 0) { if (is_log_) { std::printf("[Sense]: error during read, terminating.\n"); } set_close(); break; }
+            const auto count = static_cast<std::size_t>(bytes) / sizeof(input_event); set_batch(path_counters_[1], count, bytes); receipt_ = std::chrono::steady_clock::now();
+            set_latency(io_events_[count - 1], SOURCE_SENSOR);
+            if (capture_ != nullptr) { capture_->set_record(std::span(io_events_.data(), count), std::chrono::duration_cast<std::chrono::nanoseconds>(receipt_.time_since_epoch()).count()); }
+            for (std::size_t i = 0; i < count; ++i) { set_sensor(io_events_[i]); } if (count < io_events_.size()) { break; }
+        }
+    }
+
+    void DualSense::set_gamepad_event() {
+        while (true) {
+            const ssize_t bytes = read(js_event_path_, io_events_.data(), sizeof(io_events_));
+            if (bytes == -1 && errno == EAGAIN) { break; }
+            if (bytes <= 0 || bytes % sizeof(input_event) != 0) { if (is_log_) { std::printf("[Sense]: error during read, terminating.\n"); } set_close(); break; }
+            const auto count = static_cast<std::size_t>(bytes) / sizeof(input_event); set_batch(path_counters_[0], count, bytes); receipt_ = std::chrono::steady_clock::now(); set_latency(io_events_[count - 1], SOURCE_GAMEPAD);
+            if (capture_ != nullptr) { capture_->set_record(std::span(io_events_.data(), count), std::chrono::duration_cast<std::chrono::nanoseconds>(receipt_.time_since_epoch()).count(), SOURCE_GAMEPAD); }
+            // after `SYN_DROPPED` the events up to the next `SYN_REPORT` are incomplete, the state is loaded anew instead.
+            auto is_changed = false;
+            for (std::size_t i = 0; i < count; ++i) {
+                const auto& event = io_events_[i];
+                if (event.type == EV_SYN && event.code == SYN_DROPPED) { is_input_dropped_ = true; continue; }
+                if (is_input_dropped_) { if (event.type == EV_SYN && event.code == SYN_REPORT) { is_input_dropped_ = false; is_changed |= set_sync(); } continue; }
+                is_changed |= set_input(event);
             }
-        });
-        thread_pool_[2].detach();
+            if (is_changed) { set_publish(); }
+            for (std::size_t i = 0; i < pending_count_; ++i) { observer_.set_dispatch(pending_[i]); }
+            pending_count_ = 0; if (count < io_events_.size()) { break; }
+        }
+    }
+
+    bool DualSense::set_input(const js_event& event) {
+        if (event.type == JS_EVENT_BUTTON && event.number < BUTTON_COUNT) {
+            return set_value(state_.buttons[event.number], event.value != 0 ? EVENT_BUTTON_PRESS : EVENT_BUTTON_RELEASE, event.number, event.value, get_time(event));
+        }
+        if (event.type == JS_EVENT_AXIS && event.number < AXIS_COUNT) { return set_value(state_.axis[event.number], EVENT_AXIS, event.number, event.value, get_time(event)); }
+        return false;
+    }
+
+    bool DualSense::set_input(const input_event& event) {
+        if (event.type == EV_KEY && event.code >= BTN_SOUTH && static_cast<std::size_t>(event.code - BTN_SOUTH) < KEY_MAP.size() && KEY_MAP[event.code - BTN_SOUTH] != UNMAPPED) {
+            const auto number = KEY_MAP[event.code - BTN_SOUTH]; const auto is_pressed = event.value != 0;
+            return set_value(state_.buttons[number], is_pressed ? EVENT_BUTTON_PRESS : EVENT_BUTTON_RELEASE, number, is_pressed, get_time(event, SOURCE_GAMEPAD));
+        }
+        if (event.type == EV_ABS && event.code < ABS_MAP.size() && ABS_MAP[event.code] != UNMAPPED) {
+            const auto number = ABS_MAP[event.code];
+            return set_value(state_.axis[number], EVENT_AXIS, number, get_scaled(ranges_[number], event.value), get_time(event, SOURCE_GAMEPAD));
+        }
+        return false;
+    }
+
+    bool DualSense::set_value(int16_t& value, const SenseEventConstants type, const uint8_t number, const int16_t next, const std::chrono::steady_clock::time_point time) {
+        if (value == next) { return false; } value = next; state_.timestamp = time; if (history_ != nullptr) { history_->set_event({ type, number, next, time }); }
+        if (type != EVENT_AXIS) { state_.button_mask = static_cast<uint16_t>(next != 0 ? state_.button_mask | 1u << number : state_.button_mask & ~(1u << number)); }
+        if (observer_.is_active() && pending_count_ < pending_.size()) { pending_[pending_count_++] = { type, number, next, time }; }
+        return true;
+    }
+
+    bool DualSense::set_sync() {
+        auto is_changed = false;
+        if (std::array<uint8_t, KEY_MAX / 8 + 1> keys = {}; ioctl(js_event_path_, EVIOCGKEY(keys.size()), keys.data()) != -1) {
+            for (std::size_t i = 0; i < KEY_MAP.size(); ++i) {
+                if (KEY_MAP[i] == UNMAPPED) { continue; } const auto code = BTN_SOUTH + i; const auto is_pressed = (keys[code / 8] >> code % 8 & 1) != 0;
+                is_changed |= set_value(state_.buttons[KEY_MAP[i]], is_pressed ? EVENT_BUTTON_PRESS : EVENT_BUTTON_RELEASE, KEY_MAP[i], is_pressed, receipt_);
+            }
+        }
+        for (std::size_t code = 0; code < ABS_MAP.size(); ++code) {
+            input_absinfo info = {}; if (ABS_MAP[code] == UNMAPPED || ioctl(js_event_path_, EVIOCGABS(code), &info) == -1) { continue; }
+            ranges_[ABS_MAP[code]] = { info.minimum, info.maximum };
+            is_changed |= set_value(state_.axis[ABS_MAP[code]], EVENT_AXIS, ABS_MAP[code], get_scaled(ranges_[ABS_MAP[code]], info.value), receipt_);
+        } return is_changed;
+    }
+
+    void DualSense::set_notify(const SenseEventConstants type) {
+        if (observer_.is_active()) { observer_.set_dispatch({ type, 0, 0, std::chrono::steady_clock::now() }); }
+    }
+
+    void DualSense::set_status() {
+        // the battery has its own lock, a led write blocking on the device never stalls the input thread here.
+        if (shared_ == nullptr) { return; } const auto is_active = is_active_.load(STD_MEMORY_ORDER); auto capacity = -1;
+        if (is_active) { std::lock_guard lock(battery_lock_); capacity = get_battery(); } shared_->set_status({ capacity, is_active });
+    }
+
+    void DualSense::set_sensor(const input_event& event) {
+        if (event.type == EV_ABS && event.code <= ABS_Z) { motion_sample_.accel[event.code - ABS_X] = event.value; }
+        if (event.type == EV_ABS && event.code >= ABS_RX && event.code <= ABS_RZ) { motion_sample_.gyro[event.code - ABS_RX] = event.value; }
+        if (event.type == EV_MSC && event.code == MSC_TIMESTAMP) {
+            const auto receipt = get_time(event, SOURCE_SENSOR); const auto device_time = static_cast<uint32_t>(event.value);
+            if (device_receipt_ != std::chrono::steady_clock::time_point{}) {
+                const auto interval = static_cast<int64_t>(static_cast<uint32_t>(device_time - motion_sample_.device_time)) * 1000;
+                device_jitter_.set_value(std::abs(interval - std::chrono::duration_cast<std::chrono::nanoseconds>(receipt - device_receipt_).count()));
+            } motion_sample_.device_time = device_time; state_.device_time = device_time; device_receipt_ = receipt; current_time_ = receipt;
+        }
+        if (event.type == EV_SYN && event.code == SYN_DROPPED) { is_motion_dropped_ = true; }
+        if (event.type == EV_SYN && event.code == SYN_REPORT) {
+            if (!is_motion_dropped_) { motion_sample_.timestamp = get_time(event, SOURCE_SENSOR); if (!motion_.push(motion_sample_)) { set_count(motion_dropped_); } if (shared_ != nullptr) { shared_->set_motion(motion_sample_); } return; }
+            for (auto code = ABS_X; code <= ABS_RZ; ++code) {
+                input_absinfo info = {}; if (ioctl(io_event_path_, EVIOCGABS(code), &info) == -1) { continue; }
+                if (code <= ABS_Z) { motion_sample_.accel[code - ABS_X] = info.value; } else { motion_sample_.gyro[code - ABS_RX] = info.value; }
+            } is_motion_dropped_ = false;
+        }
+    }
+
+    void DualSense::set_batch(PathCounter& counter, const std::size_t count, const std::size_t bytes) {
+        set_count(counter.reads); counter.events.store(counter.events.load(STD_MEMORY_ORDER) + count, STD_MEMORY_ORDER);
+        counter.bytes.store(counter.bytes.load(STD_MEMORY_ORDER) + bytes, STD_MEMORY_ORDER);
+        counter.last.store(count, STD_MEMORY_ORDER); counter.max.store(std::max<uint64_t>(counter.max.load(STD_MEMORY_ORDER), count), STD_MEMORY_ORDER);
+    }
+
+    std::chrono::steady_clock::time_point DualSense::get_time(const js_event& event) {
+        // joydev stamps events with a millisecond jiffies counter, the smallest offset to the receive time is the closest estimate.
+        // a larger jump means the counter wrapped or the system resumed, so the offset is taken anew.
+        if (event.time == 0) { return receipt_; } const auto time = static_cast<int64_t>(event.time) * 1000000;
+        const auto offset = std::chrono::duration_cast<std::chrono::nanoseconds>(receipt_.time_since_epoch()).count() - time;
+        if (offset < js_offset_ || offset - js_offset_ > 1000000000) { js_offset_ = offset; }
+        return std::chrono::steady_clock::time_point(std::chrono::nanoseconds(time + js_offset_));
+    }
+
+    std::chrono::steady_clock::time_point DualSense::get_time(const input_event& event, const SenseSourceConstants source) const {
+        if (!is_kernel_time_[source]) { return receipt_; }
+        return std::chrono::steady_clock::time_point(std::chrono::seconds(event.input_event_sec) + std::chrono::microseconds(event.input_event_usec));
+    }
+
+    void DualSense::set_count(std::atomic<uint64_t>& counter) {
+        counter.store(counter.load(STD_MEMORY_ORDER) + 1, STD_MEMORY_ORDER);
+    }
+
+    void DualSense::set_latency(const input_event& event, const SenseSourceConstants source) {
+        const auto latency = std::chrono::duration_cast<std::chrono::nanoseconds>(receipt_ - get_time(event, source)).count(); if (!is_kernel_time_[source] || latency < 0) { return; }
+        receive_latency_.set_value(latency); wake_latency_[reactor_->is_busy_wake() ? 0 : 1].set_value(latency);
+    }
+
+    void DualSense::set_timeout_event() {
+        uint64_t expirations; [[maybe_unused]] const auto bytes = read(timer_path_, &expirations, sizeof(expirations));
+        const auto deadline = current_time_ + std::chrono::milliseconds(std::max(static_cast<uint16_t>(100), timeout_));
+        if (std::chrono::steady_clock::now() >= deadline) { if (is_log_) { std::printf("[Sense]: error, run into timeout.\n"); } set_count(lifecycle_counters_[2]); set_notify(EVENT_TIMEOUT); set_close(); return; }
+        // the watchdog fires about once per timeout while the device is alive, the battery is refreshed at the same pace.
+        set_timeout(deadline); set_status();
+    }
+
+    void DualSense::set_timeout(const std::chrono::steady_clock::time_point deadline) const {
+        const auto since_epoch = std::chrono::duration_cast<std::chrono::nanoseconds>(deadline.time_since_epoch()).count();
+        itimerspec spec = {}; spec.it_value.tv_sec = since_epoch / 1000000000; spec.it_value.tv_nsec = since_epoch % 1000000000;
+        timerfd_settime(timer_path_, TFD_TIMER_ABSTIME, &spec, nullptr);
     }
-} // namespace sense
\ No newline at end of file
+} // namespace sense
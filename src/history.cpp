@@ -0,0 +1,92 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Vinzenz Weist
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <cmath>
+
+#include "sense/history.h"
+
+namespace sense {
+    static constexpr auto STD_MEMORY_ORDER = std::memory_order::relaxed;
+
+    bool History::get_sample(const Track& track, const uint64_t index, Sample& sample) {
+        const auto& entry = track.entries[index & (CAPACITY - 1)];
+        const auto sequence = entry.sequence.load(std::memory_order::acquire);
+        const auto time = entry.time.load(STD_MEMORY_ORDER); const auto data = entry.data.load(STD_MEMORY_ORDER);
+        std::atomic_thread_fence(std::memory_order::acquire);
+        if (sequence != 2 * index + 2 || entry.sequence.load(STD_MEMORY_ORDER) != sequence) { return false; }
+        sample = { time, static_cast<int16_t>(data & 0xffff), (data >> 16 & 1) != 0, static_cast<uint32_t>(data >> 32) }; return true;
+    }
+
+    uint64_t History::get_upper(const Track& track, const uint64_t head, const int64_t time) {
+        // overwritten changes are the oldest ones, they sort before any time.
+        auto lower = head > CAPACITY ? head - CAPACITY : 0; auto upper = head;
+        while (lower < upper) {
+            const auto middle = lower + (upper - lower) / 2;
+            if (Sample sample = {}; !get_sample(track, middle, sample) || sample.time <= time) { lower = middle + 1; } else { upper = middle; }
+        } return lower;
+    }
+
+    uint32_t History::get_count(const Track& track, const uint64_t head, const int64_t time) {
+        const auto index = get_upper(track, head, time); Sample sample = {};
+        if (index != 0 && get_sample(track, index - 1, sample)) { return sample.presses; }
+        // nothing retained up to the time, count from just before the first retained change.
+        if (index < head && get_sample(track, index, sample)) { return sample.presses - sample.is_press; } return 0;
+    }
+
+    void History::set_event(const SenseEvent& event) {
+        const auto is_button = event.type == EVENT_BUTTON_PRESS || event.type == EVENT_BUTTON_RELEASE;
+        if ((!is_button && event.type != EVENT_AXIS) || event.number >= (is_button ? BUTTON_COUNT : AXIS_COUNT)) { return; }
+        auto& track = tracks_[is_button ? event.number : BUTTON_COUNT + event.number]; const auto is_press = event.type == EVENT_BUTTON_PRESS; track.presses += is_press;
+        const auto head = track.head.load(STD_MEMORY_ORDER); auto& entry = track.entries[head & (CAPACITY - 1)];
+        const auto data = static_cast<uint64_t>(static_cast<uint16_t>(event.value)) | static_cast<uint64_t>(is_press) << 16 | static_cast<uint64_t>(track.presses) << 32;
+        entry.sequence.store(2 * head + 1, STD_MEMORY_ORDER); std::atomic_thread_fence(std::memory_order::release);
+        entry.time.store(std::chrono::duration_cast<std::chrono::nanoseconds>(event.timestamp.time_since_epoch()).count(), STD_MEMORY_ORDER); entry.data.store(data, STD_MEMORY_ORDER);
+        entry.sequence.store(2 * head + 2, std::memory_order::release); track.head.store(head + 1, std::memory_order::release);
+    }
+
+    bool History::is_pressed_since(const SenseButtonConstants button, const std::chrono::steady_clock::time_point since) const {
+        if (button >= BUTTON_COUNT) { return false; } const auto& track = tracks_[button]; const auto head = track.head.load(std::memory_order::acquire);
+        // any later change means the button was down in the window, a release follows a press.
+        if (get_upper(track, head, std::chrono::duration_cast<std::chrono::nanoseconds>(since.time_since_epoch()).count()) < head) { return true; }
+        Sample sample = {}; return head != 0 && get_sample(track, head - 1, sample) && sample.value != 0;
+    }
+
+    std::size_t History::get_presses(const SenseButtonConstants button, const std::chrono::steady_clock::time_point begin, const std::chrono::steady_clock::time_point end) const {
+        if (button >= BUTTON_COUNT || end <= begin) { return 0; } const auto& track = tracks_[button]; const auto head = track.head.load(std::memory_order::acquire);
+        const auto first = get_count(track, head, std::chrono::duration_cast<std::chrono::nanoseconds>(begin.time_since_epoch()).count());
+        const auto last = get_count(track, head, std::chrono::duration_cast<std::chrono::nanoseconds>(end.time_since_epoch()).count());
+        // the counts cross if the retained changes were overwritten between both lookups.
+        return last > first ? last - first : 0;
+    }
+
+    int16_t History::get_axis(const SenseAxisConstants axis, const std::chrono::steady_clock::time_point time) const {
+        if (axis >= AXIS_COUNT) { return 0; } const auto& track = tracks_[BUTTON_COUNT + axis]; const auto head = track.head.load(std::memory_order::acquire);
+        const auto target = std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count(); const auto index = get_upper(track, head, target);
+        Sample before = {}; Sample after = {}; const auto is_after = index < head && get_sample(track, index, after);
+        if (index == 0 || !get_sample(track, index - 1, before)) { return is_after ? after.value : axis == AXIS_LEFT_TRIGGER || axis == AXIS_RIGHT_TRIGGER ? -32767 : 0; }
+        if (!is_after || after.time == before.time) { return before.value; }
+        const auto ratio = static_cast<double>(target - before.time) / static_cast<double>(after.time - before.time);
+        return static_cast<int16_t>(std::lround(before.value + (after.value - before.value) * ratio));
+    }
+} // namespace sense
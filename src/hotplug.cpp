@@ -0,0 +1,134 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Vinzenz Weist
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <arpa/inet.h>
+#include <cerrno>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <linux/netlink.h>
+#include <algorithm>
+#include <cstring>
+
+#include "sense/device.h"
+#include "sense/hotplug.h"
+
+namespace sense {
+    /**
+     * @brief the multicast group of kernel uevents.
+     */
+    static constexpr uint32_t KERNEL_GROUP = 1;
+
+    /**
+     * @brief the multicast group of events processed by udev.
+     */
+    static constexpr uint32_t UDEV_GROUP = 2;
+
+    /**
+     * @brief identifies a udev event, in network byte order on the wire.
+     */
+    static constexpr uint32_t UDEV_MAGIC = 0xfeedcafe;
+
+    /**
+     * @brief UdevHeader starts every event sent by udev.
+     */
+    struct UdevHeader {
+        /**
+         * @brief "libudev" and a terminating '\0'.
+         */
+        std::array<char, 8> prefix = {};
+
+        /**
+         * @brief `UDEV_MAGIC` in network byte order.
+         */
+        uint32_t magic = {};
+
+        /**
+         * @brief the size of the header.
+         */
+        uint32_t header_size = {};
+
+        /**
+         * @brief the offset of the "KEY=value" fields.
+         */
+        uint32_t properties_offset = {};
+
+        /**
+         * @brief the length of the "KEY=value" fields.
+         */
+        uint32_t properties_length = {};
+    };
+
+    Hotplug::Hotplug(std::shared_ptr<Reactor> reactor, const HotplugCallback callback, void* context): reactor_(std::move(reactor)), callback_(callback), context_(context) {
+        path_ = socket(AF_NETLINK, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, NETLINK_KOBJECT_UEVENT); if (path_ == -1) { return; }
+        // group 1 receives the kernel events, the node exists once they arrive but udev may not have applied its permissions yet.
+        // group 2 receives the same events after udev processed them, an open which failed on the kernel event succeeds then.
+        sockaddr_nl address = {}; address.nl_family = AF_NETLINK; address.nl_groups = KERNEL_GROUP | UDEV_GROUP; constexpr int enable = 1;
+        if (bind(path_, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == -1) { close(path_); path_ = -1; return; }
+        setsockopt(path_, SOL_SOCKET, SO_PASSCRED, &enable, sizeof(enable));
+        watch_ = reactor_->set_watch(path_, [this] { set_receive(); });
+    }
+
+    Hotplug::~Hotplug() {
+        reactor_->set_invoke([this] { reactor_->set_unwatch(watch_); watch_ = -1; });
+        if (path_ != -1) { close(path_); }
+    }
+
+    bool Hotplug::is_open() const {
+        return watch_ != -1;
+    }
+
+    void Hotplug::set_receive() {
+        while (true) {
+            sockaddr_nl sender = {}; iovec data = { buffer_.data(), buffer_.size() }; alignas(cmsghdr) std::array<char, CMSG_SPACE(sizeof(ucred))> control = {};
+            msghdr header = {}; header.msg_name = &sender; header.msg_namelen = sizeof(sender); header.msg_iov = &data; header.msg_iovlen = 1;
+            header.msg_control = control.data(); header.msg_controllen = control.size();
+            const ssize_t bytes = recvmsg(path_, &header, 0);
+            if (bytes == -1 && errno == ENOBUFS) { callback_({ HOTPLUG_LOST }, context_); continue; }
+            if (bytes <= 0) { break; } std::string_view message(buffer_.data(), static_cast<std::size_t>(bytes)); std::size_t begin = 0;
+
+            if (sender.nl_groups == KERNEL_GROUP && sender.nl_pid == 0) {
+                // a kernel uevent is "action@devpath" followed by "KEY=value" fields, all terminated by '\0'.
+                begin = message.find('\0');
+            } else if (sender.nl_groups == UDEV_GROUP) {
+                // a udev event carries a binary header, only root may send it.
+                const auto* credentials = CMSG_FIRSTHDR(&header); UdevHeader udev = {};
+                if (credentials == nullptr || credentials->cmsg_type != SCM_CREDENTIALS || reinterpret_cast<const ucred*>(CMSG_DATA(credentials))->uid != 0) { continue; }
+                if (message.size() < sizeof(udev)) { continue; } std::memcpy(&udev, message.data(), sizeof(udev));
+                if (std::memcmp(udev.prefix.data(), "libudev", udev.prefix.size()) != 0 || ntohl(udev.magic) != UDEV_MAGIC || udev.properties_offset == 0 || udev.properties_offset > message.size()) { continue; }
+                message = message.substr(0, std::min<std::size_t>(message.size(), std::size_t{ udev.properties_offset } + udev.properties_length)); begin = udev.properties_offset - 1;
+            } else { continue; }
+
+            HotplugEvent event = {}; std::string_view subsystem;
+            for (; begin < message.size(); ) {
+                const auto end = std::min(message.find('\0', begin + 1), message.size()); const auto field = message.substr(begin + 1, end - begin - 1); begin = end;
+                if (field == "ACTION=add") { event.action = HOTPLUG_ADD; } if (field == "ACTION=remove") { event.action = HOTPLUG_REMOVE; }
+                if (field.starts_with("DEVNAME=")) { event.name = field.substr(8); if (event.name.starts_with("/dev/")) { event.name.remove_prefix(5); } } if (field.starts_with("DEVPATH=")) { event.path = field.substr(8); }
+                if (field.starts_with("SUBSYSTEM=")) { subsystem = field.substr(10); }
+            }
+            if (event.action == 0 || subsystem != "input" || !event.name.starts_with("input/")) { continue; }
+            if (std::ranges::none_of(HID_IDS, [&event](const auto* id) { return event.path.find(id) != std::string_view::npos; })) { continue; }
+            callback_(event, context_);
+        }
+    }
+} // namespace sense
@@ -0,0 +1,95 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Vinzenz Weist
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <algorithm>
+
+#include "sense/hub.h"
+
+namespace sense {
+    DualSenseHub::DualSenseHub(const uint16_t timeout): timeout_(timeout) {}
+
+    DualSenseHub::~DualSenseHub() { hotplug_.reset(); set_close(); }
+
+    void DualSenseHub::set_logging(const bool enable) {
+        reactor_->set_invoke([this, enable] { is_log_ = enable; for (const auto& device : devices_) { if (device) { device->set_logging(enable); } } });
+    }
+
+    std::size_t DualSenseHub::set_open() {
+        // serialized with hot-plug events, which open from the reactor thread.
+        return reactor_->set_invoke([this] { topology_->set_invalidate(); return set_devices(); });
+    }
+
+    std::size_t DualSenseHub::set_devices() {
+        const auto set_seen = [this] { for (std::size_t i = 0; i < SLOT_COUNT; ++i) { if (devices_[i] && devices_[i]->is_active()) { seen_[i] = passes_; } } };
+        // an empty slot is taken first, then the one inactive the longest, a device which only disconnected likely comes back.
+        const auto get_free = [this] {
+            if (const auto empty = std::ranges::find_if(devices_, [](const auto& device) { return !device; }); empty != devices_.end()) { return empty; } auto free = devices_.end();
+            for (auto slot = devices_.begin(); slot != devices_.end(); ++slot) { if (!(*slot)->is_active() && (free == devices_.end() || seen_[slot - devices_.begin()] < seen_[free - devices_.begin()])) { free = slot; } }
+            return free;
+        };
+        ++passes_; set_seen();
+        for (auto& paths : topology_->get_devices()) {
+            // a reconnected device keeps its slot, it is identified by its address.
+            const auto is_same = [&paths](const auto& device) { return device && (paths.uniq.empty() ? device->get_paths().hid == paths.hid : device->get_paths().uniq == paths.uniq); };
+            auto free = std::ranges::find_if(devices_, is_same);
+            if (free != devices_.end() && ((*free)->is_active() || (*free)->get_paths().hid == paths.hid)) { (*free)->set_open(); continue; }
+
+            if (free == devices_.end()) { free = get_free(); } if (free == devices_.end()) { break; }
+            // a slot keeps its device for the lifetime of the hub, a new device only replaces the backend.
+            const auto slot = static_cast<std::size_t>(free - devices_.begin()); auto backend = std::make_shared<EvdevBackend>(std::move(paths));
+            if (*free) { (*free)->set_backend(std::move(backend)); } else { *free = std::make_unique<DualSense>(reactor_, std::move(backend), timeout_, &states_[slot]); }
+            (*free)->set_logging(is_log_); (*free)->set_open();
+        }
+        set_seen(); return std::ranges::count_if(devices_, [](const auto& device) { return device && device->is_active(); });
+    }
+
+    void DualSenseHub::set_close() {
+        reactor_->set_invoke([this] { for (const auto& device : devices_) { if (device) { device->set_close(); } } });
+    }
+
+    bool DualSenseHub::set_hotplug(const bool enable) {
+        if (!enable) { hotplug_.reset(); return true; } if (hotplug_) { return hotplug_->is_open(); }
+        hotplug_ = std::make_unique<Hotplug>(reactor_, [](const HotplugEvent& event, void* context) {
+            if (event.action == HOTPLUG_REMOVE) { return; } auto* hub = static_cast<DualSenseHub*>(context); hub->topology_->set_invalidate(); hub->set_devices();
+        }, this);
+        return hotplug_->is_open();
+    }
+
+    DualSense* DualSenseHub::get_device(const std::size_t slot) const {
+        return slot < SLOT_COUNT ? reactor_->set_invoke([this, slot] { return devices_[slot].get(); }) : nullptr;
+    }
+
+    ControllerState DualSenseHub::snapshot(const std::size_t slot) const {
+        return slot < SLOT_COUNT ? states_[slot].load() : ControllerState();
+    }
+
+    std::size_t DualSenseHub::snapshot(const std::span<ControllerState> states) const {
+        const auto count = std::min(states.size(), SLOT_COUNT);
+        for (std::size_t i = 0; i < count; ++i) { states[i] = states_[i].load(); } return count;
+    }
+
+    std::vector<DevicePaths> DualSenseHub::get_device_paths(const std::string& sysfs_root, const std::string& input_root) {
+        return Topology(sysfs_root, input_root).get_devices();
+    }
+} // namespace sense
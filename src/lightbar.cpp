@@ -0,0 +1,122 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Vinzenz Weist
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <algorithm>
+#include <numeric>
+
+#include "sense/lightbar.h"
+
+namespace sense {
+    /**
+     * @brief time between two battery capacity reads.
+     */
+    static constexpr auto BATTERY_INTERVAL = std::chrono::seconds(5);
+
+    /**
+     * @brief default battery levels, red when empty to green when full.
+     */
+    static constexpr std::array<Level, 3> BATTERY_LEVELS = {{ { 0, { 255, 0, 0 } }, { 50, { 255, 160, 0 } }, { 100, { 0, 255, 0 } } }};
+
+    Lightbar::Lightbar(DualSense& device, const uint16_t frame_rate): device_(device), frame_interval_(1000 / std::max(static_cast<uint16_t>(1), frame_rate)) {
+        thread_ = std::thread([this] { set_loop(); });
+    }
+
+    Lightbar::~Lightbar() {
+        { std::lock_guard lock(mailbox_lock_); is_terminated_ = true; }
+        condition_.notify_one(); if (thread_.joinable()) { thread_.join(); }
+    }
+
+    void Lightbar::set_color(const Color& color) {
+        Animation animation = {}; animation.keyframes[0] = { color, 0 }; animation.keyframe_count = 1;
+        set_post(animation);
+    }
+
+    void Lightbar::set_fade(const std::span<const Keyframe> keyframes, const bool is_repeat) {
+        Animation animation = {}; animation.keyframe_count = static_cast<uint8_t>(std::min(keyframes.size(), KEYFRAME_COUNT));
+        std::copy_n(keyframes.begin(), animation.keyframe_count, animation.keyframes.begin()); animation.is_repeat = is_repeat;
+        set_post(animation);
+    }
+
+    void Lightbar::set_pulse(const Color& color, const uint16_t period) {
+        auto dark = color; dark.brightness = 0;
+        const std::array<Keyframe, 2> keyframes = {{ { dark, static_cast<uint16_t>(period / 2) }, { color, static_cast<uint16_t>(period / 2) } }};
+        set_fade(keyframes, true);
+    }
+
+    void Lightbar::set_battery(std::span<const Level> levels) {
+        if (levels.empty()) { levels = BATTERY_LEVELS; }
+        Animation animation = {}; animation.level_count = static_cast<uint8_t>(std::min(levels.size(), KEYFRAME_COUNT));
+        std::copy_n(levels.begin(), animation.level_count, animation.levels.begin());
+        set_post(animation);
+    }
+
+    void Lightbar::set_post(const Animation& animation) {
+        { std::lock_guard lock(mailbox_lock_); mailbox_ = animation; version_++; }
+        condition_.notify_one();
+    }
+
+    Color Lightbar::get_mix(const Color& from, const Color& to, const float ratio) {
+        const auto mix = [ratio](const uint8_t lhs, const uint8_t rhs) { return static_cast<uint8_t>(static_cast<float>(lhs) + (static_cast<float>(rhs) - static_cast<float>(lhs)) * ratio + 0.5f); };
+        return { mix(from.red, to.red), mix(from.green, to.green), mix(from.blue, to.blue), mix(from.brightness, to.brightness) };
+    }
+
+    void Lightbar::set_loop() {
+        Animation animation = {}; uint64_t version = {}; Color current = {}; Color from = {}; auto is_written = false;
+        auto start = std::chrono::steady_clock::now(); auto battery_time = start; auto capacity = -1;
+        std::unique_lock lock(mailbox_lock_);
+
+        while (!is_terminated_) {
+            if (version != version_) { animation = mailbox_; version = version_; from = current; start = battery_time = std::chrono::steady_clock::now(); }
+            lock.unlock();
+
+            const auto now = std::chrono::steady_clock::now(); auto target = current; auto next = std::chrono::steady_clock::time_point::max();
+            if (animation.level_count != 0) {
+                if (now >= battery_time) { capacity = device_.get_capacity(); battery_time = now + BATTERY_INTERVAL; } next = battery_time;
+                const auto levels = std::span(animation.levels.data(), animation.level_count);
+                const auto upper = std::ranges::find_if(levels, [capacity](const auto& level) { return level.capacity >= capacity; });
+                if (capacity < 0) { target = current; }
+                else if (upper == levels.begin()) { target = levels.front().color; }
+                else if (upper == levels.end()) { target = levels.back().color; }
+                else { const auto& lower = *(upper - 1); target = get_mix(lower.color, upper->color, static_cast<float>(capacity - lower.capacity) / static_cast<float>(upper->capacity - lower.capacity)); }
+            } else if (animation.keyframe_count != 0) {
+                const auto keyframes = std::span(animation.keyframes.data(), animation.keyframe_count);
+                const auto total = std::accumulate(keyframes.begin(), keyframes.end(), int64_t{}, [](const auto sum, const auto& keyframe) { return sum + keyframe.duration; });
+                auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - start).count(); auto previous = from;
+                if (animation.is_repeat && total > 0 && elapsed >= total) { elapsed %= total; previous = keyframes.back().color; }
+                target = keyframes.back().color;
+                for (const auto& keyframe : keyframes) {
+                    if (elapsed < keyframe.duration) { target = get_mix(previous, keyframe.color, static_cast<float>(elapsed) / keyframe.duration); break; }
+                    elapsed -= keyframe.duration; previous = keyframe.color;
+                }
+                const auto is_running = animation.is_repeat ? total > 0 : now - start < std::chrono::milliseconds(total);
+                if (is_running) { next = now + frame_interval_; }
+            }
+
+            if (const auto is_animated = animation.keyframe_count != 0 || animation.level_count != 0; is_animated && (target != current || !is_written)) { device_.set_led(target.red, target.green, target.blue, target.brightness); current = target; is_written = true; }
+            lock.lock();
+            const auto is_ready = [this, version] { return is_terminated_ || version != version_; };
+            if (next == std::chrono::steady_clock::time_point::max()) { condition_.wait(lock, is_ready); } else { condition_.wait_until(lock, next, is_ready); }
+        }
+    }
+} // namespace sense
@@ -0,0 +1,58 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Vinzenz Weist
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "sense/metrics.h"
+
+namespace sense {
+    uint64_t HistogramSnapshot::get_percentile(const double ratio) const {
+        const auto target = static_cast<uint64_t>(ratio * static_cast<double>(count)); uint64_t total = 0;
+        for (std::size_t i = 0; i < buckets.size(); ++i) {
+            total += buckets[i]; if (total > target) { return i == 0 ? 0 : i >= 64 ? UINT64_MAX : (uint64_t{1} << i) - 1; }
+        } return count == 0 ? 0 : UINT64_MAX;
+    }
+
+    HistogramSnapshot Histogram::get_snapshot() const {
+        HistogramSnapshot snapshot = {};
+        for (std::size_t i = 0; i < buckets_.size(); ++i) { snapshot.buckets[i] = buckets_[i].load(std::memory_order::relaxed); snapshot.count += snapshot.buckets[i]; }
+        snapshot.sum = sum_.load(std::memory_order::relaxed); return snapshot;
+    }
+
+    std::string Metrics::get_text(const std::string& prefix) const {
+        std::string text; const auto set_line = [&text, &prefix](const std::string& name, const uint64_t value) { text += prefix + name + " " + std::to_string(value) + "\n"; };
+        for (const auto& [name, path] : { std::pair{ std::string("input"), &input }, std::pair{ std::string("sensor"), &sensor } }) {
+            set_line(name + "_reads_total", path->reads); set_line(name + "_events_total", path->events); set_line(name + "_bytes_total", path->bytes);
+            set_line(name + "_batch_last", path->last_batch); set_line(name + "_batch_max", path->max_batch);
+        }
+        set_line("snapshot_retries_total", snapshot_retries); set_line("motion_dropped_total", motion_dropped);
+        set_line("opens_total", opens); set_line("closes_total", closes); set_line("timeouts_total", timeouts);
+        for (const auto& [name, histogram] : { std::pair{ std::string("receive_latency_ns"), &receive_latency }, std::pair{ std::string("busy_latency_ns"), &busy_latency }, std::pair{ std::string("sleep_latency_ns"), &sleep_latency },
+                                                std::pair{ std::string("device_jitter_ns"), &device_jitter }, std::pair{ std::string("led_latency_ns"), &led_latency } }) {
+            set_line(name + "_count", histogram->count); set_line(name + "_sum", histogram->sum);
+            set_line(name + "{quantile=\"0.5\"}", histogram->get_percentile(0.5));
+            set_line(name + "{quantile=\"0.99\"}", histogram->get_percentile(0.99));
+            set_line(name + "{quantile=\"0.999\"}", histogram->get_percentile(0.999));
+        }
+        return text;
+    }
+} // namespace sense
@@ -0,0 +1,104 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Vinzenz Weist
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <bit>
+#include <climits>
+#include <cstdlib>
+#include <thread>
+
+#include "sense/observer.h"
+
+namespace sense {
+    /**
+     * @brief one dispatch on the stack of the current thread.
+     */
+    struct DispatchFrame {
+        /**
+         * @brief the dispatching observer.
+         */
+        const Observer* observer = nullptr;
+
+        /**
+         * @brief the enclosing dispatch, nullptr for the outermost one.
+         */
+        const DispatchFrame* previous = nullptr;
+    };
+
+    /**
+     * @brief the innermost dispatch on this thread, callbacks may dispatch again by closing a device.
+     */
+    static thread_local const DispatchFrame* dispatching = nullptr;
+
+    /**
+     * @brief check if an observer is dispatching anywhere up the stack of the current thread.
+     *
+     * @param observer the observer.
+     */
+    static bool is_dispatching(const Observer* observer) {
+        for (const auto* frame = dispatching; frame != nullptr; frame = frame->previous) { if (frame->observer == observer) { return true; } } return false;
+    }
+
+    int Observer::set_subscribe(const SenseCallback callback, void* context, const uint8_t events, const uint16_t threshold) {
+        if (callback == nullptr) { return -1; }
+        auto claimed = claimed_.load();
+        while (true) {
+            if (claimed == UINT32_MAX >> (32 - SUBSCRIPTION_COUNT)) { return -1; }
+            const auto slot = std::countr_one(claimed);
+            if (!claimed_.compare_exchange_weak(claimed, claimed | 1u << slot)) { continue; }
+            subscriptions_[slot].store({ callback, context, events, threshold, generation_.fetch_add(1) + 1 });
+            active_.fetch_or(1u << slot); return slot;
+        }
+    }
+
+    void Observer::set_unsubscribe(const int id) {
+        if (id < 0 || static_cast<std::size_t>(id) >= SUBSCRIPTION_COUNT) { return; }
+        if ((active_.fetch_and(~(1u << id)) & 1u << id) == 0) { return; }
+        // wait for the outermost dispatch which may still see the slot, unless it is up the stack of this thread.
+        if (!is_dispatching(this)) {
+            const auto epoch = epoch_.load(); while (dispatches_.load() != 0 && epoch_.load() == epoch) { std::this_thread::yield(); }
+        }
+        subscriptions_[id].store({}); claimed_.fetch_and(~(1u << id));
+    }
+
+    bool Observer::is_active() const {
+        return active_.load(std::memory_order::relaxed) != 0;
+    }
+
+    void Observer::set_dispatch(const SenseEvent& event) {
+        const DispatchFrame frame = { this, dispatching }; dispatching = &frame; dispatches_.fetch_add(1);
+        for (auto active = active_.load(); active != 0; active &= active - 1) {
+            const auto slot = static_cast<std::size_t>(std::countr_zero(active));
+            const auto subscription = subscriptions_[slot].load();
+            if ((subscription.events & event.type) == 0 || subscription.callback == nullptr) { continue; }
+            if (event.type == EVENT_AXIS) {
+                if (axis_generation_[slot] != subscription.generation) { axis_[slot].fill(INT32_MIN); axis_generation_[slot] = subscription.generation; }
+                auto& reference = axis_[slot][event.number];
+                if (reference != INT32_MIN && std::abs(event.value - reference) < subscription.threshold) { continue; }
+                reference = event.value;
+            }
+            subscription.callback(event, subscription.context);
+        }
+        dispatching = frame.previous; if (dispatches_.fetch_sub(1) == 1) { epoch_.fetch_add(1); }
+    }
+} // namespace sense
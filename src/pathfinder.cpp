@@ -22,6 +22,8 @@
  * SOFTWARE.
  */
 
+#include <fcntl.h>
+#include <unistd.h>
 #include <fstream>
 
 #include "sense/pathfinder.h"
@@ -29,7 +31,7 @@
 namespace sense {
     Pathfinder::Pathfinder() = default;
 
-    Pathfinder::~Pathfinder() = default;
+    Pathfinder::~Pathfinder() { set_close(); }
 
     std::string Pathfinder::get_value(const std::string& path) {
         auto value = std::string();
@@ -41,4 +43,29 @@ namespace sense {
         stream_.open(path, std::fstream::out);
         stream_ << value; stream_.close();
     }
-} // namespace sense
\ No newline at end of file
+
+    bool Pathfinder::set_open(const SensePathConstants id, const std::string& path, const int flags) {
+        if (paths_[id] != -1) { close(paths_[id]); }
+        paths_[id] = open(path.c_str(), flags | O_CLOEXEC); return paths_[id] != -1;
+    }
+
+    void Pathfinder::set_close() {
+        for (auto& path : paths_) { if (path != -1) { close(path); path = -1; } }
+    }
+
+    bool Pathfinder::is_open(const SensePathConstants id) const {
+        return paths_[id] != -1;
+    }
+
+    std::string_view Pathfinder::get_value(const SensePathConstants id, const std::span<char> buffer) const {
+        if (paths_[id] == -1) { return {}; }
+        const ssize_t bytes = pread(paths_[id], buffer.data(), buffer.size(), 0); if (bytes <= 0) { return {}; }
+        const auto value = std::string_view(buffer.data(), static_cast<std::size_t>(bytes));
+        return value.substr(0, value.find_first_of(" \n"));
+    }
+
+    bool Pathfinder::set_value(const SensePathConstants id, const std::string_view value) const {
+        if (paths_[id] == -1) { return false; }
+        return pwrite(paths_[id], value.data(), value.size(), 0) == static_cast<ssize_t>(value.size());
+    }
+} // namespace sense
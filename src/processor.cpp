@@ -0,0 +1,71 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Vinzenz Weist
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include "sense/processor.h"
+
+namespace sense {
+    /**
+     * @brief the axis pairs of both thumb sticks.
+     */
+    static constexpr std::array<std::array<std::size_t, 2>, 2> STICKS = {{ { AXIS_LEFT_THUMB_X, AXIS_LEFT_THUMB_Y }, { AXIS_RIGHT_THUMB_X, AXIS_RIGHT_THUMB_Y } }};
+
+    Processor::Processor(const InputProfile& profile): radial_deadzone_(std::clamp(profile.radial_deadzone, 0.0f, 0.99f)) {
+        for (std::size_t i = 0; i < AXIS_COUNT; ++i) {
+            const auto& axis = profile.axis[i]; const auto center = static_cast<float>(axis.center); const auto deadzone = std::clamp(axis.deadzone, 0.0f, 0.99f);
+            center_[i] = center; deadzone_[i] = deadzone; range_[i] = 1.0f / (1.0f - deadzone); curve_[i] = std::clamp(axis.curve, 0.0f, 1.0f);
+            positive_[i] = axis.maximum > axis.center ? 1.0f / (static_cast<float>(axis.maximum) - center) : 0.0f;
+            negative_[i] = axis.center > axis.minimum ? 1.0f / (center - static_cast<float>(axis.minimum)) : 0.0f;
+        }
+    }
+
+    void Processor::get_axis(const std::array<int16_t, AXIS_COUNT>& raw, std::array<float, AXIS_COUNT>& axis) const {
+        using Short = int16_t __attribute__((vector_size(AXIS_COUNT * sizeof(int16_t))));
+        constexpr Vector ZERO = {}; constexpr Vector ONE = ZERO + 1.0f;
+        Short input; std::memcpy(&input, raw.data(), sizeof(input));
+
+        // calibrate, each side of the center has its own scale.
+        auto value = __builtin_convertvector(input, Vector) - center_;
+        value *= value >= 0.0f ? positive_ : negative_;
+        value = value > 1.0f ? ONE : value < -1.0f ? -ONE : value;
+
+        // the radial deadzone rescales the magnitude of a stick and keeps its direction.
+        if (radial_deadzone_ > 0.0f) {
+            for (const auto& [x, y] : STICKS) {
+                const auto magnitude = std::sqrt(value[x] * value[x] + value[y] * value[y]);
+                const auto scale = magnitude <= radial_deadzone_ ? 0.0f : std::min(1.0f, (magnitude - radial_deadzone_) / (1.0f - radial_deadzone_)) / magnitude;
+                value[x] *= scale; value[y] *= scale;
+            }
+        }
+
+        // the axial deadzone rescales each axis, then the curve blends linear into cubic.
+        const auto magnitude = value < 0.0f ? -value : value; auto scaled = (magnitude - deadzone_) * range_;
+        scaled = scaled < 0.0f ? ZERO : scaled; value = value < 0.0f ? -scaled : scaled;
+        value += curve_ * (value * value * value - value);
+        std::memcpy(axis.data(), &value, sizeof(value));
+    }
+} // namespace sense
@@ -0,0 +1,117 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Vinzenz Weist
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <pthread.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "sense/reactor.h"
+
+namespace sense {
+    static constexpr auto STD_MEMORY_ORDER = std::memory_order::relaxed;
+
+    Reactor::Reactor(): epoll_fd_(epoll_create1(EPOLL_CLOEXEC)), wake_fd_(eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)) {
+        epoll_event event = {}; event.events = EPOLLIN; event.data.u64 = UINT64_MAX;
+        epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, wake_fd_, &event);
+        thread_ = std::thread([this] { set_loop(); });
+    }
+
+    Reactor::~Reactor() {
+        is_terminated_.store(true, STD_MEMORY_ORDER);
+        constexpr uint64_t value = 1; [[maybe_unused]] const auto bytes = write(wake_fd_, &value, sizeof(value));
+        // on the reactor thread the loop is past its last access, it only checks the flag and returns.
+        if (thread_.joinable()) { if (is_reactor_thread()) { *is_destroyed_ = true; thread_.detach(); } else { thread_.join(); } }
+        close(wake_fd_); close(epoll_fd_);
+    }
+
+    int Reactor::set_watch(const int fd, std::function<void()> handler) {
+        std::lock_guard lock(dispatch_lock_);
+        for (std::size_t i = 0; i < WATCH_COUNT; ++i) {
+            auto& watch = watches_[i]; if (watch.state != WatchState::FREE) { continue; }
+            epoll_event event = {}; event.events = EPOLLIN;
+            event.data.u64 = static_cast<uint64_t>(watch.generation + 1) << 32 | i;
+            if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &event) == -1) { return -1; }
+            watch.handler = std::move(handler); watch.fd = fd; watch.generation++; watch.state = WatchState::ACTIVE;
+            return static_cast<int>(i);
+        } return -1;
+    }
+
+    void Reactor::set_unwatch(const int id) {
+        if (id < 0 || static_cast<std::size_t>(id) >= WATCH_COUNT) { return; }
+        std::lock_guard lock(dispatch_lock_); auto& watch = watches_[id];
+        if (watch.state != WatchState::ACTIVE) { return; }
+        // events already returned by epoll_wait are dropped by the state and generation check.
+        epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, watch.fd, nullptr); watch.fd = -1;
+        if (is_reactor_thread()) { watch.state = WatchState::RETIRED; } else { watch.handler = {}; watch.state = WatchState::FREE; }
+    }
+
+    bool Reactor::is_reactor_thread() const {
+        return std::this_thread::get_id() == thread_.get_id();
+    }
+
+    bool Reactor::is_busy_wake() const {
+        return is_busy_wake_;
+    }
+
+    bool Reactor::set_scheduling(const SchedulingOptions& options) {
+        auto result = true; busy_poll_.store(std::chrono::duration_cast<std::chrono::nanoseconds>(options.busy_poll).count(), STD_MEMORY_ORDER);
+        sched_param param = {}; param.sched_priority = options.policy == SCHED_FIFO || options.policy == SCHED_RR ? options.priority : 0;
+        result &= pthread_setschedparam(thread_.native_handle(), options.policy, &param) == 0;
+        if (options.cpus != 0) {
+            cpu_set_t cpus; CPU_ZERO(&cpus); for (int cpu = 0; cpu < 64; ++cpu) { if ((options.cpus >> cpu & 1) != 0) { CPU_SET(cpu, &cpus); } }
+            result &= pthread_setaffinity_np(thread_.native_handle(), sizeof(cpus), &cpus) == 0;
+        }
+        // faults in the stack of every thread and all mapped pages, later mappings are locked as they appear.
+        if (options.is_locked) { result &= mlockall(MCL_CURRENT | MCL_FUTURE) == 0; } return result;
+    }
+
+    void Reactor::set_loop() {
+        std::array<epoll_event, EVENT_COUNT> events = {}; bool is_destroyed = false; is_destroyed_ = &is_destroyed;
+        while (!is_terminated_.load(STD_MEMORY_ORDER)) {
+            // spinning on a zero timeout skips the scheduler wakeup, the window restarts after every round.
+            int count = 0; is_busy_wake_ = false;
+            if (const auto busy_poll = busy_poll_.load(STD_MEMORY_ORDER); busy_poll > 0) {
+                const auto deadline = std::chrono::steady_clock::now() + std::chrono::nanoseconds(busy_poll);
+                while ((count = epoll_wait(epoll_fd_, events.data(), EVENT_COUNT, 0)) == 0 && std::chrono::steady_clock::now() < deadline) {}
+                is_busy_wake_ = count > 0;
+            }
+            if (count == 0) { count = epoll_wait(epoll_fd_, events.data(), EVENT_COUNT, -1); } if (count <= 0) { continue; }
+            // a handler may drop the last owner, the reference defers the destruction until the round is complete.
+            auto self = weak_from_this().lock();
+            {
+                std::lock_guard lock(dispatch_lock_);
+                for (int i = 0; i < count; ++i) {
+                    if (events[i].data.u64 == UINT64_MAX) { uint64_t value; [[maybe_unused]] const auto bytes = read(wake_fd_, &value, sizeof(value)); continue; }
+                    const auto slot = static_cast<std::size_t>(events[i].data.u64 & UINT32_MAX);
+                    const auto generation = static_cast<uint32_t>(events[i].data.u64 >> 32);
+                    if (auto& watch = watches_[slot]; watch.state == WatchState::ACTIVE && watch.generation == generation) { watch.handler(); }
+                }
+                for (auto& watch : watches_) { if (watch.state == WatchState::RETIRED) { watch.handler = {}; watch.state = WatchState::FREE; } }
+            }
+            self.reset(); if (is_destroyed) { return; }
+        }
+    }
+} // namespace sense
@@ -0,0 +1,97 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Vinzenz Weist
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <linux/input.h>
+#include <algorithm>
+
+#include "sense/rumble.h"
+
+namespace sense {
+    Rumble::Rumble(DualSense& device): device_(device) {
+        thread_ = std::thread([this] { set_loop(); });
+    }
+
+    Rumble::~Rumble() {
+        { std::lock_guard lock(mailbox_lock_); is_terminated_ = true; }
+        condition_.notify_one(); if (thread_.joinable()) { thread_.join(); }
+    }
+
+    void Rumble::set_vibration(const Vibration& vibration) {
+        { std::lock_guard lock(mailbox_lock_); mailbox_ = vibration; version_++; }
+        condition_.notify_one();
+    }
+
+    void Rumble::set_stop() {
+        set_vibration({});
+    }
+
+    void Rumble::set_loop() {
+        uint64_t version = {}; std::unique_lock lock(mailbox_lock_);
+        while (!is_terminated_) {
+            // only the latest vibration is applied, posts in between are coalesced.
+            // a failed node is reopened once, it belongs to a previous connection.
+            if (version != version_) {
+                const auto vibration = mailbox_; version = version_; lock.unlock();
+                if (!set_apply(vibration)) { set_close(); if (!set_apply(vibration)) { set_close(); } } lock.lock(); continue;
+            }
+            condition_.wait(lock, [this, version] { return is_terminated_ || version != version_; });
+        }
+        lock.unlock(); set_apply({}); set_close();
+    }
+
+    bool Rumble::set_apply(const Vibration& vibration) {
+        if (path_ == -1 && (vibration.strong != 0 || vibration.weak != 0)) {
+            // the backend looks up a missing gamepad node under the roots it was built with.
+            const auto gamepad = device_.get_device_paths().gamepad;
+            if (!gamepad.empty()) { path_ = open(gamepad.c_str(), O_RDWR | O_NONBLOCK | O_CLOEXEC); }
+        }
+        if (path_ == -1) { return true; }
+        if (vibration.strong == 0 && vibration.weak == 0) { const auto is_stopped = playing_ == -1 || set_play(playing_, false); playing_ = -1; return is_stopped; }
+
+        // an uploaded effect with the same vibration is replayed, otherwise the least recently played one is updated.
+        auto effect = std::ranges::find(effects_, vibration, &Effect::vibration);
+        if (effect == effects_.end() || effect->id == -1) {
+            effect = std::ranges::min_element(effects_, {}, &Effect::used);
+            ff_effect upload = {}; upload.type = FF_RUMBLE; upload.id = effect->id; upload.replay.length = vibration.duration;
+            upload.u.rumble.strong_magnitude = vibration.strong; upload.u.rumble.weak_magnitude = vibration.weak;
+            if (ioctl(path_, EVIOCSFF, &upload) == -1) { return false; }
+            effect->vibration = vibration; effect->id = upload.id;
+        }
+        if (playing_ != -1 && playing_ != effect->id) { set_play(playing_, false); }
+        effect->used = ++plays_; playing_ = effect->id; return set_play(effect->id, true);
+    }
+
+    bool Rumble::set_play(const int16_t id, const bool is_playing) const {
+        input_event event = {}; event.type = EV_FF; event.code = static_cast<uint16_t>(id); event.value = is_playing ? 1 : 0;
+        return write(path_, &event, sizeof(event)) == sizeof(event);
+    }
+
+    void Rumble::set_close() {
+        if (path_ != -1) { close(path_); path_ = -1; }
+        effects_ = {}; playing_ = -1;
+    }
+} // namespace sense
@@ -0,0 +1,106 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Vinzenz Weist
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <new>
+
+#include "sense/shared.h"
+
+namespace sense {
+    SharedWriter::SharedWriter(const std::string& name): name_(name) {
+        path_ = name_.empty() ? memfd_create("sense", MFD_CLOEXEC | MFD_ALLOW_SEALING) : shm_open(name_.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+        if (path_ == -1 || ftruncate(path_, sizeof(SharedRegion)) == -1) { return; }
+        // readers map a fixed size, an anonymous region can neither shrink nor grow below them.
+        if (name_.empty()) { fcntl(path_, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_SEAL); }
+        if (void* data = mmap(nullptr, sizeof(SharedRegion), PROT_READ | PROT_WRITE, MAP_SHARED, path_, 0); data != MAP_FAILED) {
+            region_ = new (data) SharedRegion(); region_->version.store(SHARED_VERSION, std::memory_order::release);
+        }
+    }
+
+    SharedWriter::~SharedWriter() {
+        if (region_ != nullptr) { munmap(region_, sizeof(SharedRegion)); }
+        if (path_ != -1) { close(path_); if (!name_.empty()) { shm_unlink(name_.c_str()); } }
+    }
+
+    bool SharedWriter::is_open() const {
+        return region_ != nullptr;
+    }
+
+    int SharedWriter::get_path() const {
+        return path_;
+    }
+
+    void SharedWriter::set_state(const ControllerState& state) {
+        if (region_ != nullptr) { region_->state.store(state); }
+    }
+
+    void SharedWriter::set_motion(const MotionSample& sample) {
+        if (region_ != nullptr) { region_->motion.store(sample); }
+    }
+
+    void SharedWriter::set_status(const SharedStatus& status) {
+        if (region_ != nullptr) { region_->status.store(status); }
+    }
+
+    SharedReader::SharedReader(const std::string& name) {
+        const int path = shm_open(name.c_str(), O_RDONLY | O_CLOEXEC, 0); if (path == -1) { return; }
+        set_map(path); close(path);
+    }
+
+    SharedReader::SharedReader(const int path) {
+        set_map(path);
+    }
+
+    SharedReader::~SharedReader() {
+        if (region_ != nullptr) { munmap(const_cast<SharedRegion*>(region_), sizeof(SharedRegion)); }
+    }
+
+    void SharedReader::set_map(const int path) {
+        if (struct stat info = {}; fstat(path, &info) == -1 || static_cast<std::size_t>(info.st_size) < sizeof(SharedRegion)) { return; }
+        void* data = mmap(nullptr, sizeof(SharedRegion), PROT_READ, MAP_SHARED, path, 0); if (data == MAP_FAILED) { return; }
+        // the version is stored after the layout is complete, a region of another layout is rejected.
+        const auto* region = static_cast<const SharedRegion*>(data);
+        if (region->version.load(std::memory_order::acquire) != SHARED_VERSION || region->magic != SharedRegion().magic || region->size != sizeof(SharedRegion)) { munmap(data, sizeof(SharedRegion)); return; }
+        region_ = region;
+    }
+
+    bool SharedReader::is_open() const {
+        return region_ != nullptr;
+    }
+
+    ControllerState SharedReader::snapshot() const {
+        return region_ != nullptr ? region_->state.load() : ControllerState();
+    }
+
+    MotionSample SharedReader::get_motion() const {
+        return region_ != nullptr ? region_->motion.load() : MotionSample();
+    }
+
+    SharedStatus SharedReader::get_status() const {
+        return region_ != nullptr ? region_->status.load() : SharedStatus();
+    }
+} // namespace sense
@@ -0,0 +1,108 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Vinzenz Weist
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <unistd.h>
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <utility>
+
+#include "sense/topology.h"
+
+namespace sense {
+    static std::string get_hid_path(const std::filesystem::path& path) {
+        std::error_code error; const auto hid = std::filesystem::canonical(path, error);
+        return error ? std::string() : hid.string();
+    }
+
+    static std::string get_line(const std::filesystem::path& path) {
+        std::ifstream stream(path); std::string line; std::getline(stream, line); return line;
+    }
+
+    Topology::Topology(std::string sysfs_root, std::string input_root): sysfs_root_(std::move(sysfs_root)), input_root_(std::move(input_root)) {}
+
+    std::shared_ptr<Topology> Topology::get_shared(const std::string& sysfs_root, const std::string& input_root) {
+        static std::mutex lock; static std::map<std::pair<std::string, std::string>, std::shared_ptr<Topology>> topologies;
+        std::lock_guard guard(lock); auto& topology = topologies[{ sysfs_root, input_root }];
+        if (!topology) { topology = std::make_shared<Topology>(sysfs_root, input_root); } return topology;
+    }
+
+    std::vector<DevicePaths> Topology::get_devices() {
+        std::lock_guard lock(lock_); if (!is_valid_) { set_build(); } return devices_;
+    }
+
+    DevicePaths Topology::get_device(const std::string_view key) {
+        std::lock_guard lock(lock_); if (!is_valid_) { set_build(); }
+        // a reconnected device gets a new hid parent, the old one disappears.
+        if (const auto* device = get_entry(key); device != nullptr && access(device->hid.c_str(), F_OK) == 0) { return *device; }
+        if (key == missing_) { return {}; } set_build();
+        if (const auto* device = get_entry(key); device != nullptr) { return *device; }
+        missing_ = key; return {};
+    }
+
+    void Topology::set_invalidate() {
+        std::lock_guard lock(lock_); is_valid_ = false;
+    }
+
+    const DevicePaths* Topology::get_entry(const std::string_view key) const {
+        if (key.empty()) { return nullptr; }
+        const auto device = std::ranges::find_if(devices_, [key](const auto& paths) { return paths.input == key || paths.gamepad == key || paths.sensor == key || paths.uniq == key; });
+        return device == devices_.end() ? nullptr : &*device;
+    }
+
+    void Topology::set_build() {
+        namespace fs = std::filesystem; std::error_code error; devices_.clear(); missing_.clear(); is_valid_ = true;
+        const auto get_device = [this](const std::string& hid) { const auto device = std::ranges::find(devices_, hid, &DevicePaths::hid); return device == devices_.end() ? nullptr : &*device; };
+
+        // joystick nodes define the devices, the event node of the same input device is the gamepad node.
+        std::vector<fs::path> events;
+        for (const auto& entry : fs::directory_iterator(sysfs_root_ + "input/", error)) {
+            const auto name = entry.path().filename().string(); if (name.starts_with("event")) { events.push_back(entry.path()); }
+            if (!name.starts_with("js")) { continue; }
+            const auto hid = get_hid_path(entry.path() / "device" / "device"); if (hid.empty()) { continue; }
+            const auto hid_name = fs::path(hid).filename().string();
+            if (std::ranges::none_of(HID_IDS, [&hid_name](const auto* id) { return hid_name.find(id) != std::string::npos; })) { continue; }
+            auto& device = devices_.emplace_back(DevicePaths{ .input = input_root_ + name, .hid = hid, .uniq = get_line(entry.path() / "device" / "uniq") });
+            for (const auto& child : fs::directory_iterator(entry.path() / "device", error)) {
+                if (child.path().filename().string().starts_with("event")) { device.gamepad = input_root_ + child.path().filename().string(); }
+            }
+        }
+        if (devices_.empty()) { return; }
+
+        for (const auto& event : events) {
+            auto* device = get_device(get_hid_path(event / "device" / "device"));
+            if (device != nullptr && get_line(event / "device" / "name").ends_with("Motion Sensors")) { device->sensor = input_root_ + event.filename().string(); }
+        }
+        for (const auto& entry : fs::directory_iterator(sysfs_root_ + "leds/", error)) {
+            if (entry.path().filename().string().find(":rgb:indicator") == std::string::npos) { continue; }
+            if (auto* device = get_device(get_hid_path(entry.path() / "device")); device != nullptr) { device->led = entry.path().string(); }
+        }
+        for (const auto& entry : fs::directory_iterator(sysfs_root_ + "power_supply/", error)) {
+            if (!entry.path().filename().string().starts_with("ps-controller-battery-")) { continue; }
+            if (auto* device = get_device(get_hid_path(entry.path() / "device")); device != nullptr) { device->battery = entry.path().string(); }
+        }
+        std::ranges::sort(devices_, [](const auto& lhs, const auto& rhs) { return lhs.input.size() != rhs.input.size() ? lhs.input.size() < rhs.input.size() : lhs.input < rhs.input; });
+    }
+} // namespace sense
@@ -0,0 +1,46 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Vinzenz Weist
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <sense/history.h>
+
+int main() {
+    const auto history = std::make_unique<sense::History>(); const auto start = std::chrono::steady_clock::now(); auto failures = 0;
+    const auto at = [start](const int milliseconds) { return start + std::chrono::milliseconds(milliseconds); };
+    const auto check = [&failures](const bool condition, const char* name) { if (!condition) { std::printf("failed: %s\n", name); ++failures; } };
+
+    // three presses of cross at 10, 30 and 50 ms, each released 10 ms later.
+    for (const auto time : { 10, 30, 50 }) {
+        history->set_event({ sense::EVENT_BUTTON_PRESS, sense::BUTTON_CROSS, 1, at(time) });
+        history->set_event({ sense::EVENT_BUTTON_RELEASE, sense::BUTTON_CROSS, 0, at(time + 10) });
+    }
+    check(history->get_presses(sense::BUTTON_CROSS, at(0), at(100)) == 3, "all presses");
+    check(history->get_presses(sense::BUTTON_CROSS, at(20), at(40)) == 1, "window");
+    check(history->get_presses(sense::BUTTON_CROSS, at(100), at(0)) == 0, "reversed window");
+    check(history->get_presses(sense::BUTTON_CROSS, at(30), at(30)) == 0, "empty window");
+    check(history->get_presses(sense::BUTTON_CIRCLE, at(0), at(100)) == 0, "untouched button");
+    return failures == 0 ? 0 : 1;
+}